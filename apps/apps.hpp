@@ -7,7 +7,7 @@
 
 namespace yall {
 
-  auto dbl_printer = [](const double& d) { std::cout << d << " <--> "; };
+  inline auto dbl_printer = [](const double& d) { std::cout << d << " <--> "; };
 
   template<typename T>
   void fn_a(Yall<T>& llist) {
@@ -37,11 +37,11 @@ namespace yall {
   };
 
 
-  std::ostream& operator<<(std::ostream& os, const Foo& p) {
+  inline std::ostream& operator<<(std::ostream& os, const Foo& p) {
     return os << "name: \"" << p.name << "\", id: " << p.id;
   }
 
-  auto foo_printer = [](const yall::Foo& foo) { std::cout << foo << " <--> "; };
+  inline auto foo_printer = [](const yall::Foo& foo) { std::cout << foo << " <--> "; };
 
   template<typename T>
   void fn_b(Yall<T>& llist) {
@@ -26,4 +26,11 @@ int main() {
 
   std::cout << "\nmax element: " << *max_foo << '\n';
   std::cout << "min element: " << *min_foo << '\n';
+
+  // relinks the nodes, no Foo is copied
+  ll_foo.sort();
+  std::cout << "\nsorted:\n";
+  for (const auto& foo : ll_foo) {
+    std::cout << foo << '\n';
+  }
 }
\ No newline at end of file
@@ -0,0 +1,230 @@
+// Yall compared to std::list and std::deque for value, Foo and reference
+// payloads. Every benchmark keeps the container at state.range(0) elements.
+#include "apps.hpp"
+#include "yall.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+  using yall::Foo;
+
+  template<typename P>
+  using SharedYall = yall::Yall<P>;
+  template<typename P>
+  using UniqueYall =
+          yall::Yall<P, std::allocator<std::decay_t<P>>, yall::UniqueOwnership>;
+
+  // the standard containers hold references through std::reference_wrapper
+  template<typename P>
+  using Elem = std::conditional_t<std::is_reference_v<P>,
+                                  std::reference_wrapper<std::decay_t<P>>, P>;
+  template<typename P>
+  using StdList = std::list<Elem<P>>;
+  template<typename P>
+  using StdDeque = std::deque<Elem<P>>;
+
+  // payload i, reference payloads refer to a vector owned by the generator
+  template<typename P>
+  struct Values {
+    explicit Values(int64_t) {}
+    P operator()(int64_t i) const {
+      if constexpr (std::is_same_v<P, Foo>) {
+        return Foo("foo" + std::to_string(i), static_cast<int>(i));
+      } else {
+        return static_cast<P>(i);
+      }
+    }
+  };
+
+  template<>
+  struct Values<double&> {
+    explicit Values(int64_t len) : store(static_cast<size_t>(len) + 1) {
+      std::iota(store.begin(), store.end(), 0.0);
+    }
+    double& operator()(int64_t i) { return store[static_cast<size_t>(i)]; }
+
+    std::vector<double> store;
+  };
+
+  double key(double d) { return d; }
+  double key(const Foo& foo) { return foo.id; }
+
+  template<typename C, typename Gen>
+  void fill(C& c, Gen& values, int64_t len) {
+    for (int64_t i = 0; i < len; ++i) {
+      c.push_back(values(i));
+    }
+  }
+
+  template<typename C, typename V>
+  void insert_at(C& c, size_t indx, V&& val) {
+    if constexpr (requires { c.insert_at(indx, val); }) {
+      c.insert_at(indx, std::forward<V>(val));
+    } else {
+      c.insert(std::next(c.begin(), static_cast<std::ptrdiff_t>(indx)),
+               std::forward<V>(val));
+    }
+  }
+
+  template<typename C, typename V>
+  bool remove_first(C& c, V& val) {
+    if constexpr (requires { c.remove_first(val); }) {
+      return c.remove_first(val);
+    } else {
+      auto it = std::find(c.begin(), c.end(), val);
+      if (it == c.end()) {
+        return false;
+      }
+      c.erase(it);
+      return true;
+    }
+  }
+
+  template<typename C, typename V>
+  bool remove_last(C& c, V& val) {
+    if constexpr (requires { c.remove_last(val); }) {
+      return c.remove_last(val);
+    } else {
+      auto it = std::find(c.rbegin(), c.rend(), val);
+      if (it == c.rend()) {
+        return false;
+      }
+      c.erase(std::next(it).base());
+      return true;
+    }
+  }
+
+  template<typename C, typename P>
+  void BM_PushPopBack(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    for (auto _: state) {
+      c.push_back(values(0));
+      c.pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  template<typename C, typename P>
+  void BM_PushPopFront(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    for (auto _: state) {
+      c.push_front(values(0));
+      c.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // insert in the middle, trim the back
+  template<typename C, typename P>
+  void BM_InsertAt(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    const auto mid = static_cast<size_t>(state.range(0) / 2);
+    for (auto _: state) {
+      insert_at(c, mid, values(0));
+      c.pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // worst case, the match is at the back and is put back there
+  template<typename C, typename P>
+  void BM_RemoveFirst(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    for (auto _: state) {
+      auto&& val = values(state.range(0) - 1);
+      benchmark::DoNotOptimize(remove_first(c, val));
+      c.push_back(val);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  // worst case, the match is at the front and is put back there
+  template<typename C, typename P>
+  void BM_RemoveLast(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    for (auto _: state) {
+      auto&& val = values(0);
+      benchmark::DoNotOptimize(remove_last(c, val));
+      c.push_front(val);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<typename C, typename P>
+  void BM_Iterate(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    for (auto _: state) {
+      double sum = 0;
+      for (const auto& e: c) {
+        sum += key(e);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<typename C, typename P>
+  void BM_Size(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    C c;
+    fill(c, values, state.range(0));
+    for (auto _: state) {
+      benchmark::DoNotOptimize(c.size());
+    }
+  }
+
+  // construction with push_back plus teardown
+  template<typename C, typename P>
+  void BM_BuildDestroy(benchmark::State& state) {
+    Values<P> values(state.range(0));
+    for (auto _: state) {
+      C c;
+      fill(c, values, state.range(0));
+      benchmark::DoNotOptimize(c.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void sizes(benchmark::internal::Benchmark* bm) {
+    bm->RangeMultiplier(10)->Range(10, 10'000'000);
+  }
+}// namespace
+
+#define YALL_COMPARE(bm, P)                                                    \
+  BENCHMARK_TEMPLATE(bm, SharedYall<P>, P)->Apply(sizes);                      \
+  BENCHMARK_TEMPLATE(bm, UniqueYall<P>, P)->Apply(sizes);                      \
+  BENCHMARK_TEMPLATE(bm, StdList<P>, P)->Apply(sizes);                         \
+  BENCHMARK_TEMPLATE(bm, StdDeque<P>, P)->Apply(sizes)
+
+#define YALL_COMPARE_PAYLOADS(bm)                                              \
+  YALL_COMPARE(bm, double);                                                    \
+  YALL_COMPARE(bm, Foo);                                                       \
+  YALL_COMPARE(bm, double&)
+
+YALL_COMPARE_PAYLOADS(BM_PushPopBack);
+YALL_COMPARE_PAYLOADS(BM_PushPopFront);
+YALL_COMPARE_PAYLOADS(BM_InsertAt);
+YALL_COMPARE_PAYLOADS(BM_RemoveFirst);
+YALL_COMPARE_PAYLOADS(BM_RemoveLast);
+YALL_COMPARE_PAYLOADS(BM_Iterate);
+YALL_COMPARE_PAYLOADS(BM_Size);
+YALL_COMPARE_PAYLOADS(BM_BuildDestroy);
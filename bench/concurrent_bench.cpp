@@ -0,0 +1,144 @@
+// Throughput of the concurrent lists, with the coarse alternative, a Yall
+// behind one mutex, for comparison.
+#include "yall.hpp"
+#include "yall_concurrent.hpp"
+#include "yall_finelock.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+  constexpr int items = 1 << 18;
+
+  // what the lock-free queue replaces, a Yall behind a single mutex
+  class LockedQueue {
+  public:
+    void push_back(int val) {
+      std::lock_guard lock(mtx);
+      list.push_back(val);
+    }
+    std::optional<int> try_pop_front() {
+      std::lock_guard lock(mtx);
+      return list.pop_front_value();
+    }
+
+  private:
+    std::mutex mtx;
+    yall::Yall<int, std::allocator<int>, yall::UniqueOwnership> list;
+  };
+
+  template<typename Queue>
+  void BM_Queue(benchmark::State& state) {
+    const auto producers = static_cast<int>(state.range(0));
+    const auto consumers = static_cast<int>(state.range(1));
+
+    for (auto _: state) {
+      Queue queue;
+      std::atomic<int> popped{0};
+      std::vector<std::thread> threads;
+      for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p, producers] {
+          for (int i = p; i < items; i += producers) {
+            queue.push_back(i);
+          }
+        });
+      }
+      for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&queue, &popped] {
+          while (popped.load(std::memory_order_relaxed) < items) {
+            if (queue.try_pop_front()) {
+              popped.fetch_add(1, std::memory_order_relaxed);
+            }
+          }
+        });
+      }
+      for (auto& thread: threads) {
+        thread.join();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+  }
+
+  void threads(benchmark::internal::Benchmark* bm) {
+    for (int producers: {1, 2, 4, 8}) {
+      for (int consumers: {1, 2, 4, 8}) {
+        bm->Args({producers, consumers});
+      }
+    }
+    bm->ArgNames({"producers", "consumers"})
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+  }
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_Queue, yall::ConcurrentYall<int>)->Apply(threads);
+BENCHMARK_TEMPLATE(BM_Queue, LockedQueue)->Apply(threads);
+
+// Mid-list edits: every thread moves values around its own anchor, so with
+// per-node locks the threads only meet while walking past each other.
+namespace {
+  constexpr int region = 64;
+
+  // a Yall behind a single mutex, with the FineLockYall edit calls
+  class LockedList {
+  public:
+    void push_back(int val) {
+      std::lock_guard lock(mtx);
+      list.push_back(val);
+    }
+    bool remove_first(int val) {
+      std::lock_guard lock(mtx);
+      return list.remove_first(val);
+    }
+    bool insert_after(int match, int val) {
+      std::lock_guard lock(mtx);
+      return list.insert_after(match, val);
+    }
+
+  private:
+    std::mutex mtx;
+    yall::Yall<int, std::allocator<int>, yall::UniqueOwnership> list;
+  };
+
+  template<typename List>
+  void BM_DisjointEdits(benchmark::State& state) {
+    const auto n_threads = static_cast<int>(state.range(0));
+    constexpr int edits  = 4096;
+
+    for (auto _: state) {
+      state.PauseTiming();
+      List list;
+      for (int val = 0; val < n_threads * region; ++val) {
+        list.push_back(val);
+      }
+      state.ResumeTiming();
+
+      std::vector<std::thread> threads;
+      for (int t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&list, t] {
+          const int anchor = t * region;
+          for (int i = 0; i < edits; ++i) {
+            const int val = anchor + 1 + i % (region - 1);
+            list.remove_first(val);
+            list.insert_after(anchor, val);
+          }
+        });
+      }
+      for (auto& thread: threads) {
+        thread.join();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * n_threads * edits);
+  }
+
+  void edit_threads(benchmark::internal::Benchmark* bm) {
+    bm->ArgName("threads")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+  }
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_DisjointEdits, yall::FineLockYall<int>)
+        ->Apply(edit_threads);
+BENCHMARK_TEMPLATE(BM_DisjointEdits, LockedList)->Apply(edit_threads);
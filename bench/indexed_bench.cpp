@@ -0,0 +1,94 @@
+#include "apps.hpp"
+#include "yall.hpp"
+#include "yall_indexed.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+  using yall::Foo;
+
+  struct FooHash {
+    std::size_t operator()(const Foo& foo) const {
+      return std::hash<int>{}(foo.id);
+    }
+  };
+
+  using UniqueList  = yall::Yall<Foo, std::allocator<Foo>, yall::UniqueOwnership>;
+  using IndexedList = yall::IndexedYall<Foo, FooHash>;
+
+  // session like entries, the names are too long for the small string buffer
+  Foo session(int64_t i) {
+    return Foo("session-" + std::to_string(i) + "-0123456789",
+               static_cast<int>(i));
+  }
+
+  template<typename List>
+  void fill(List& list, int64_t len) {
+    for (int64_t i = 0; i < len; ++i) {
+      list.push_back(session(i));
+    }
+  }
+
+  // remove a random entry by key and add it back at the end
+  template<typename List>
+  void BM_RemoveByKey(benchmark::State& state) {
+    List list;
+    fill(list, state.range(0));
+    std::mt19937 gen(42);
+    std::vector<Foo> keys;
+    for (int i = 0; i < 1024; ++i) {
+      keys.push_back(session(gen() % state.range(0)));
+    }
+    std::size_t k = 0;
+    for (auto _: state) {
+      const auto& key = keys[k++ % keys.size()];
+      benchmark::DoNotOptimize(list.remove_first(key));
+      list.push_back(key);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // what the index costs when nothing is looked up
+  template<typename List>
+  void BM_BuildDestroy(benchmark::State& state) {
+    for (auto _: state) {
+      List list;
+      fill(list, state.range(0));
+      benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+#if defined(__GLIBC__)
+  // heap bytes per element, the Foo string included
+  template<typename List>
+  void BM_Memory(benchmark::State& state) {
+    std::size_t bytes = 0;
+    for (auto _: state) {
+      const auto before = mallinfo2().uordblks;
+      List list;
+      fill(list, state.range(0));
+      bytes = mallinfo2().uordblks - before;
+    }
+    state.counters["bytes_per_element"] =
+            static_cast<double>(bytes) / static_cast<double>(state.range(0));
+  }
+#endif
+}// namespace
+
+BENCHMARK(BM_RemoveByKey<UniqueList>)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_RemoveByKey<IndexedList>)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+BENCHMARK(BM_BuildDestroy<UniqueList>)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BuildDestroy<IndexedList>)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+#if defined(__GLIBC__)
+BENCHMARK(BM_Memory<UniqueList>)->Arg(1 << 16)->Iterations(1);
+BENCHMARK(BM_Memory<IndexedList>)->Arg(1 << 16)->Iterations(1);
+#endif
@@ -0,0 +1,117 @@
+// Checkpointing a list to memory and back: the binary save/load against
+// writing the values as text and parsing them again, which is what a
+// print() callback amounts to.
+#include "apps.hpp"
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <sstream>
+
+namespace {
+  constexpr int length = 1'000'000;
+
+  using DoubleList =
+          yall::Yall<double, std::allocator<double>, yall::UniqueOwnership>;
+  using FooList = yall::Yall<yall::Foo, std::allocator<yall::Foo>,
+                             yall::UniqueOwnership>;
+
+  struct FooCodec {
+    void write(std::ostream& os, const yall::Foo& foo) {
+      const auto len = static_cast<std::uint32_t>(foo.name.size());
+      os.write(reinterpret_cast<const char*>(&len), sizeof(len));
+      os.write(foo.name.data(), len);
+      os.write(reinterpret_cast<const char*>(&foo.id), sizeof(foo.id));
+    }
+    std::optional<yall::Foo> read(std::istream& is) {
+      std::uint32_t len = 0;
+      is.read(reinterpret_cast<char*>(&len), sizeof(len));
+      std::string name(len, '\0');
+      is.read(name.data(), len);
+      int id = 0;
+      is.read(reinterpret_cast<char*>(&id), sizeof(id));
+      if (!is) {
+        return {};
+      }
+      return yall::Foo(std::move(name), id);
+    }
+  };
+
+  DoubleList doubles() {
+    DoubleList list;
+    for (int i = 0; i < length; ++i) {
+      list.push_back(i * 0.25);
+    }
+    return list;
+  }
+
+  FooList foos() {
+    FooList list;
+    for (int i = 0; i < length; ++i) {
+      list.emplace_back("foo" + std::to_string(i % 1000), i);
+    }
+    return list;
+  }
+
+  void BM_SaveLoadText(benchmark::State& state) {
+    auto list = doubles();
+    for (auto _: state) {
+      std::stringstream buf;
+      buf.precision(17);
+      for (double d: list) {
+        buf << d << '\n';
+      }
+      DoubleList loaded;
+      for (double d; buf >> d;) {
+        loaded.push_back(d);
+      }
+      benchmark::DoNotOptimize(loaded.size());
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_SaveLoadBinary(benchmark::State& state) {
+    auto list = doubles();
+    for (auto _: state) {
+      std::stringstream buf;
+      list.save(buf);
+      DoubleList loaded;
+      loaded.load(buf);
+      benchmark::DoNotOptimize(loaded.size());
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_SaveLoadFooText(benchmark::State& state) {
+    auto list = foos();
+    for (auto _: state) {
+      std::stringstream buf;
+      for (const auto& foo: list) {
+        buf << foo.name << ' ' << foo.id << '\n';
+      }
+      FooList loaded;
+      std::string name;
+      for (int id; buf >> name >> id;) {
+        loaded.emplace_back(name, id);
+      }
+      benchmark::DoNotOptimize(loaded.size());
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_SaveLoadFooCodec(benchmark::State& state) {
+    auto list = foos();
+    for (auto _: state) {
+      std::stringstream buf;
+      list.save(buf, FooCodec{});
+      FooList loaded;
+      loaded.load(buf, FooCodec{});
+      benchmark::DoNotOptimize(loaded.size());
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+}// namespace
+
+BENCHMARK(BM_SaveLoadText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SaveLoadBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SaveLoadFooText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SaveLoadFooCodec)->Unit(benchmark::kMillisecond);
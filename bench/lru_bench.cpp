@@ -0,0 +1,139 @@
+// A cache of 1M entries: LruCache against the same cache over std::list and
+// against keeping the recency order in a plain Yall, where every hit is a
+// remove_first plus a push_front. Hits use random keys that are all cached,
+// the eviction runs put new keys only, the mixed runs draw keys from 1.25
+// times the capacity and put the misses.
+#include "yall.hpp"
+#include "yall_lru.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  constexpr std::int64_t capacity = 1 << 20;
+
+  // the textbook LRU cache, for comparison
+  class StdLru {
+    struct Entry {
+      std::int64_t key;
+      std::int64_t value;
+    };
+
+  public:
+    explicit StdLru(std::size_t capacity_) : max_size(capacity_) {}
+
+    std::int64_t* get(std::int64_t key) {
+      auto found = index.find(key);
+      if (found == index.end()) {
+        return nullptr;
+      }
+      entries.splice(entries.begin(), entries, found->second);
+      return &found->second->value;
+    }
+
+    void put(std::int64_t key, std::int64_t value) {
+      if (auto found = index.find(key); found != index.end()) {
+        found->second->value = value;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+      }
+      if (entries.size() == max_size) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+      }
+      entries.push_front({key, value});
+      index.emplace(key, entries.begin());
+    }
+
+  private:
+    std::list<Entry> entries;
+    std::unordered_map<std::int64_t, std::list<Entry>::iterator> index;
+    std::size_t max_size;
+  };
+
+  using Lru = yall::LruCache<std::int64_t, std::int64_t>;
+
+  template<typename Cache>
+  Cache filled() {
+    Cache cache(capacity);
+    for (std::int64_t i = 0; i < capacity; ++i) {
+      cache.put(i, i);
+    }
+    return cache;
+  }
+
+  std::vector<std::int64_t> random_keys(std::int64_t range) {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<std::int64_t> dist(0, range - 1);
+    std::vector<std::int64_t> keys(1 << 16);
+    for (auto& key: keys) {
+      key = dist(rng);
+    }
+    return keys;
+  }
+
+  template<typename Cache>
+  void BM_GetHit(benchmark::State& state) {
+    auto cache       = filled<Cache>();
+    const auto keys  = random_keys(capacity);
+    std::size_t next = 0;
+    for (auto _: state) {
+      benchmark::DoNotOptimize(cache.get(keys[next++ & (keys.size() - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  template<typename Cache>
+  void BM_PutEvict(benchmark::State& state) {
+    auto cache       = filled<Cache>();
+    std::int64_t key = capacity;
+    for (auto _: state) {
+      cache.put(key, key);
+      ++key;
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  template<typename Cache>
+  void BM_Mixed(benchmark::State& state) {
+    auto cache       = filled<Cache>();
+    const auto keys  = random_keys(capacity + capacity / 4);
+    std::size_t next = 0;
+    for (auto _: state) {
+      const auto key = keys[next++ & (keys.size() - 1)];
+      if (!cache.get(key)) {
+        cache.put(key, key);
+      }
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // a hit the way it's done with Yall alone
+  void BM_GetHitYall(benchmark::State& state) {
+    yall::Yall<std::int64_t, std::allocator<std::int64_t>,
+               yall::UniqueOwnership>
+            order;
+    for (std::int64_t i = 0; i < capacity; ++i) {
+      order.push_front(i);
+    }
+    const auto keys  = random_keys(capacity);
+    std::size_t next = 0;
+    for (auto _: state) {
+      const auto key = keys[next++ & (keys.size() - 1)];
+      order.remove_first(key);
+      order.push_front(key);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_GetHit, Lru);
+BENCHMARK_TEMPLATE(BM_GetHit, StdLru);
+BENCHMARK(BM_GetHitYall)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PutEvict, Lru);
+BENCHMARK_TEMPLATE(BM_PutEvict, StdLru);
+BENCHMARK_TEMPLATE(BM_Mixed, Lru);
+BENCHMARK_TEMPLATE(BM_Mixed, StdLru);
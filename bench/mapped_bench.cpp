@@ -0,0 +1,82 @@
+// Getting a saved list back at startup: opening a MappedYall file against
+// load() of the same values saved with save().
+#include "yall.hpp"
+#include "yall_mapped.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+  constexpr int length = 1'000'000;
+
+  using DoubleList =
+          yall::Yall<double, std::allocator<double>, yall::UniqueOwnership>;
+
+  std::string temp_file(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  void BM_StartupLoad(benchmark::State& state) {
+    const auto path = temp_file("yall_bench_load.bin");
+    {
+      DoubleList list;
+      for (int i = 0; i < length; ++i) {
+        list.push_back(i * 0.25);
+      }
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      list.save(out);
+    }
+    for (auto _: state) {
+      std::ifstream in(path, std::ios::binary);
+      DoubleList loaded;
+      loaded.load(in);
+      benchmark::DoNotOptimize(loaded.back_val());
+    }
+    std::filesystem::remove(path);
+  }
+
+  void BM_StartupMapped(benchmark::State& state) {
+    const auto path = temp_file("yall_bench_mapped.bin");
+    std::filesystem::remove(path);
+    {
+      yall::MappedYall<double> list;
+      list.open(path);
+      for (int i = 0; i < length; ++i) {
+        list.push_back(i * 0.25);
+      }
+    }
+    for (auto _: state) {
+      yall::MappedYall<double> mapped;
+      mapped.open(path);
+      benchmark::DoNotOptimize(mapped.back_val());
+    }
+    std::filesystem::remove(path);
+  }
+
+  // a full pass after opening, the pages come in as they are touched
+  void BM_StartupMappedScan(benchmark::State& state) {
+    const auto path = temp_file("yall_bench_mapped_scan.bin");
+    std::filesystem::remove(path);
+    {
+      yall::MappedYall<double> list;
+      list.open(path);
+      for (int i = 0; i < length; ++i) {
+        list.push_back(i * 0.25);
+      }
+    }
+    for (auto _: state) {
+      yall::MappedYall<double> mapped;
+      mapped.open(path);
+      double sum = 0;
+      for (double d: mapped) {
+        sum += d;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    std::filesystem::remove(path);
+  }
+}// namespace
+
+BENCHMARK(BM_StartupLoad)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupMapped)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StartupMappedScan)->Unit(benchmark::kMillisecond);
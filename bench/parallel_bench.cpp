@@ -0,0 +1,114 @@
+// The parallel algorithms over a 10M element list, against the plain
+// sequential walk, for 1 to 8 threads. Reduce does next to nothing per
+// element, count_if does some arithmetic, the "Presplit" runs reuse one
+// Segments so the cost of the split walk is left out. The "Short" runs are
+// on 32K elements, where handing the segments out is most of the cost.
+#include "yall.hpp"
+#include "yall_parallel.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <numeric>
+
+namespace {
+  constexpr int length = 10'000'000;
+
+  using List = yall::pmr::Yall<double, yall::UniqueOwnership>;
+
+  // built once, on a pool so the nodes sit close together, and shared by
+  // every benchmark
+  List& big_list() {
+    static yall::NodePool pool{1 << 16};
+    static List list = [] {
+      List l(&pool);
+      for (int i = 0; i < length; ++i) {
+        l.push_back(i % 1000);
+      }
+      return l;
+    }();
+    return list;
+  }
+
+  bool costly(double val) { return std::sin(std::sqrt(val)) > 0.5; }
+
+  void BM_SeqReduce(benchmark::State& state) {
+    auto& list = big_list();
+    for (auto _: state) {
+      benchmark::DoNotOptimize(
+              std::accumulate(list.begin(), list.end(), 0.0));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_ParReduce(benchmark::State& state) {
+    auto& list = big_list();
+    const auto threads = static_cast<unsigned>(state.range(0));
+    for (auto _: state) {
+      benchmark::DoNotOptimize(yall::par_reduce(list, 0.0, std::plus<>{},
+                                                std::identity{}, threads));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_ParReducePresplit(benchmark::State& state) {
+    auto& list = big_list();
+    const yall::Segments segs(list, static_cast<unsigned>(state.range(0)));
+    for (auto _: state) {
+      benchmark::DoNotOptimize(yall::par_reduce(segs, 0.0, std::plus<>{}));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_SeqCountIf(benchmark::State& state) {
+    auto& list = big_list();
+    for (auto _: state) {
+      benchmark::DoNotOptimize(
+              std::count_if(list.begin(), list.end(), costly));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_ParCountIf(benchmark::State& state) {
+    auto& list = big_list();
+    const auto threads = static_cast<unsigned>(state.range(0));
+    for (auto _: state) {
+      benchmark::DoNotOptimize(yall::par_count_if(list, costly, threads));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  void BM_ParCountIfShort(benchmark::State& state) {
+    static const auto list = [] {
+      List l;
+      for (int i = 0; i < (1 << 15); ++i) {
+        l.push_back(i);
+      }
+      return l;
+    }();
+    const yall::Segments segs(list, static_cast<unsigned>(state.range(0)));
+    for (auto _: state) {
+      benchmark::DoNotOptimize(yall::par_count_if(
+              segs, [](double val) { return val < 100.0; }));
+    }
+    state.SetItemsProcessed(state.iterations() * (1 << 15));
+  }
+
+  void threads(benchmark::internal::Benchmark* bm) {
+    bm->ArgName("threads")
+            ->RangeMultiplier(2)
+            ->Range(1, 8)
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+  }
+}// namespace
+
+BENCHMARK(BM_SeqReduce)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParReduce)->Apply(threads);
+BENCHMARK(BM_ParReducePresplit)->Apply(threads);
+BENCHMARK(BM_SeqCountIf)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParCountIf)->Apply(threads);
+BENCHMARK(BM_ParCountIfShort)
+        ->ArgName("threads")
+        ->RangeMultiplier(2)
+        ->Range(1, 8)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
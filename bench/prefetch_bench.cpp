@@ -0,0 +1,78 @@
+// Scans of a list far bigger than the last level cache, with the nodes
+// scattered over memory: find_if, which prefetches ahead, against the same
+// search with the iterators, which don't. The predicate does state.range(0)
+// rounds of arithmetic per node, the time per node is reported.
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+
+namespace {
+  constexpr int length = 1 << 22;
+
+  using List = yall::Yall<std::uint64_t, std::allocator<std::uint64_t>,
+                          yall::UniqueOwnership>;
+
+  // random values, sorted: sorting relinks the nodes, so walking the list
+  // jumps all over the heap
+  const List& scattered() {
+    static const List list = [] {
+      List l;
+      std::mt19937_64 rng(7);
+      for (int i = 0; i < length; ++i) {
+        l.push_back(rng() | 1);
+      }
+      l.sort();
+      return l;
+    }();
+    return list;
+  }
+
+  // never true, the values are odd
+  bool miss(std::uint64_t val, std::int64_t work) {
+    for (std::int64_t i = 0; i < work; ++i) {
+      val = val * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return val == 0;
+  }
+
+  void set_counters(benchmark::State& state) {
+    state.counters["per_node"] = benchmark::Counter(
+            length, benchmark::Counter::kIsIterationInvariantRate |
+                            benchmark::Counter::kInvert);
+  }
+
+  void BM_ScanIterator(benchmark::State& state) {
+    const auto& list = scattered();
+    const auto work  = state.range(0);
+    for (auto _: state) {
+      auto it = list.begin();
+      for (; it != list.end() && !miss(*it, work); ++it) {}
+      benchmark::DoNotOptimize(it);
+    }
+    set_counters(state);
+  }
+
+  void BM_ScanFindIf(benchmark::State& state) {
+    const auto& list = scattered();
+    const auto work  = state.range(0);
+    for (auto _: state) {
+      auto it = list.find_if([work](std::uint64_t val) {
+        return miss(val, work);
+      });
+      benchmark::DoNotOptimize(it);
+    }
+    set_counters(state);
+  }
+}// namespace
+
+BENCHMARK(BM_ScanIterator)
+        ->Arg(0)
+        ->Arg(64)
+        ->Arg(256)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScanFindIf)
+        ->Arg(0)
+        ->Arg(64)
+        ->Arg(256)
+        ->Unit(benchmark::kMillisecond);
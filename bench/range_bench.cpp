@@ -0,0 +1,68 @@
+// Loading a list from a vector, push_back one value at a time against
+// append_range, with the default allocator and with a NodePool.
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <vector>
+
+namespace {
+  using SharedList = yall::Yall<double>;
+  using UniqueList =
+          yall::Yall<double, std::allocator<double>, yall::UniqueOwnership>;
+  using SharedPoolList = yall::pmr::Yall<double>;
+  using UniquePoolList = yall::pmr::Yall<double, yall::UniqueOwnership>;
+
+  std::vector<double> values(int64_t len) {
+    std::vector<double> vals(static_cast<size_t>(len));
+    std::iota(vals.begin(), vals.end(), 0.0);
+    return vals;
+  }
+
+  // a list on a pool that lives across iterations, or on the default heap
+  template<typename List>
+  struct Fixture {
+    List make() {
+      if constexpr (std::is_constructible_v<List, yall::NodePool*>) {
+        return List(&pool);
+      } else {
+        return List();
+      }
+    }
+    yall::NodePool pool{1024};
+  };
+
+  template<typename List>
+  void BM_PushBackLoop(benchmark::State& state) {
+    const auto vals = values(state.range(0));
+    Fixture<List> fixture;
+    for (auto _: state) {
+      auto list = fixture.make();
+      for (auto d: vals) {
+        list.push_back(d);
+      }
+      benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<typename List>
+  void BM_AppendRange(benchmark::State& state) {
+    const auto vals = values(state.range(0));
+    Fixture<List> fixture;
+    for (auto _: state) {
+      auto list = fixture.make();
+      list.append_range(vals);
+      benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}// namespace
+
+BENCHMARK(BM_PushBackLoop<SharedList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendRange<SharedList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackLoop<UniqueList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendRange<UniqueList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackLoop<SharedPoolList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendRange<SharedPoolList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackLoop<UniquePoolList>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendRange<UniquePoolList>)->Range(1 << 10, 1 << 20);
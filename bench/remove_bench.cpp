@@ -0,0 +1,56 @@
+// Dropping every match of a value from a list of 64K: the remove_first loop,
+// which starts again from the head for each match, against remove_all, one
+// pass however many match. state.range(0) values are matches, spread evenly
+// over the list. Refilling the list is not timed.
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+  constexpr int length = 1 << 16;
+
+  using List = yall::Yall<int, std::allocator<int>, yall::UniqueOwnership>;
+
+  void fill(List& list, int matches) {
+    const int step = length / matches;
+    for (int i = 0; i < length; ++i) {
+      list.push_back(i % step == 0 ? -1 : i);
+    }
+  }
+
+  void BM_RemoveFirstLoop(benchmark::State& state) {
+    const auto matches = static_cast<int>(state.range(0));
+    for (auto _: state) {
+      state.PauseTiming();
+      List list;
+      fill(list, matches);
+      state.ResumeTiming();
+      while (list.remove_first(-1)) {}
+      state.PauseTiming();
+      list.reset();
+      state.ResumeTiming();
+    }
+  }
+
+  void BM_RemoveAll(benchmark::State& state) {
+    const auto matches = static_cast<int>(state.range(0));
+    for (auto _: state) {
+      state.PauseTiming();
+      List list;
+      fill(list, matches);
+      state.ResumeTiming();
+      benchmark::DoNotOptimize(list.remove_all(-1));
+      state.PauseTiming();
+      list.reset();
+      state.ResumeTiming();
+    }
+  }
+}// namespace
+
+BENCHMARK(BM_RemoveFirstLoop)
+        ->RangeMultiplier(16)
+        ->Range(16, 4096)
+        ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RemoveAll)
+        ->RangeMultiplier(16)
+        ->Range(16, 4096)
+        ->Unit(benchmark::kMicrosecond);
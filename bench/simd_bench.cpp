@@ -0,0 +1,48 @@
+// Search by value: Yall compares one value per node it hops to, UnrolledYall
+// compares a vector of values at a time within each chunk. Every search
+// misses, so the whole list is scanned. Build with YALL_NATIVE_ARCH for the
+// AVX2 compares, SSE2 otherwise.
+#include "yall.hpp"
+#include "yall_unrolled.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+namespace {
+  template<typename P>
+  using UniqueYall = yall::Yall<P, std::allocator<P>, yall::UniqueOwnership>;
+
+  template<typename List>
+  void BM_FindMissing(benchmark::State& state) {
+    List list;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.push_back(static_cast<std::decay_t<decltype(*list.begin())>>(i));
+    }
+    for (auto _: state) {
+      auto it = list.find(-1);
+      benchmark::DoNotOptimize(it);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<typename List>
+  void BM_Count(benchmark::State& state) {
+    List list;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.push_back(static_cast<std::decay_t<decltype(*list.begin())>>(i % 7));
+    }
+    for (auto _: state) {
+      benchmark::DoNotOptimize(list.count(3));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_FindMissing, UniqueYall<double>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMissing, yall::UnrolledYall<double>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMissing, yall::UnrolledYall<double, 64>)
+        ->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMissing, UniqueYall<int>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMissing, yall::UnrolledYall<int>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_FindMissing, yall::UnrolledYall<int, 64>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Count, yall::UnrolledYall<int, 64>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Count, yall::UnrolledYall<double, 64>)->Arg(1 << 20);
@@ -0,0 +1,69 @@
+// Positional inserts and lookups at random positions, SkipYall against the
+// walk of Yall::insert_at. Yall only gets the smaller sizes, its inserts are
+// linear in the position.
+#include "yall.hpp"
+#include "yall_skip.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+namespace {
+  constexpr int ops = 1000;
+
+  using YallList = yall::Yall<int, std::allocator<int>, yall::UniqueOwnership>;
+
+  template<typename List>
+  List filled(int64_t len) {
+    List list;
+    for (int i = 0; i < len; ++i) {
+      list.push_back(i);
+    }
+    return list;
+  }
+
+  std::vector<size_t> positions(int64_t len) {
+    std::mt19937 gen(42);
+    std::vector<size_t> pos(ops);
+    for (auto& p: pos) {
+      p = gen() % static_cast<size_t>(len);
+    }
+    return pos;
+  }
+
+  // insert then erase at the same spot, so the length stays put
+  template<typename List>
+  void BM_PositionalEdit(benchmark::State& state) {
+    auto list      = filled<List>(state.range(0));
+    const auto pos = positions(state.range(0));
+    for (auto _: state) {
+      for (auto p: pos) {
+        list.insert_at(p, -1);
+        if constexpr (requires { list.erase_at(p); }) {
+          list.erase_at(p);
+        } else {
+          list.remove_first(-1);
+        }
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * ops);
+  }
+
+  void BM_At(benchmark::State& state) {
+    const auto list = filled<yall::SkipYall<int>>(state.range(0));
+    const auto pos  = positions(state.range(0));
+    for (auto _: state) {
+      for (auto p: pos) {
+        benchmark::DoNotOptimize(list.at(p));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * ops);
+  }
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_PositionalEdit, YallList)
+        ->RangeMultiplier(10)
+        ->Range(1000, 100'000);
+BENCHMARK_TEMPLATE(BM_PositionalEdit, yall::SkipYall<int>)
+        ->RangeMultiplier(10)
+        ->Range(1000, 1'000'000);
+BENCHMARK(BM_At)->RangeMultiplier(10)->Range(1000, 1'000'000);
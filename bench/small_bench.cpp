@@ -0,0 +1,38 @@
+// Short lived short lists, the pending list of a connection say: create,
+// fill with a few values, walk them, destroy. SmallYall keeps 8 nodes inline
+// and only goes to the heap past that, the 16 element runs show the spill.
+#include "yall.hpp"
+#include "yall_small.hpp"
+#include <benchmark/benchmark.h>
+#include <list>
+
+namespace {
+  template<typename List>
+  void BM_ShortLived(benchmark::State& state) {
+    const auto length = static_cast<int>(state.range(0));
+    for (auto _: state) {
+      List list;
+      for (int i = 0; i < length; ++i) {
+        list.push_back(i);
+      }
+      int sum = 0;
+      for (int val: list) {
+        sum += val;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+  }
+
+  using SharedList = yall::Yall<int>;
+  using UniqueList =
+          yall::Yall<int, std::allocator<int>, yall::UniqueOwnership>;
+  using SmallList = yall::SmallYall<int, 8>;
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_ShortLived, SharedList)->RangeMultiplier(2)->Range(1, 16);
+BENCHMARK_TEMPLATE(BM_ShortLived, UniqueList)->RangeMultiplier(2)->Range(1, 16);
+BENCHMARK_TEMPLATE(BM_ShortLived, std::list<int>)
+        ->RangeMultiplier(2)
+        ->Range(1, 16);
+BENCHMARK_TEMPLATE(BM_ShortLived, SmallList)->RangeMultiplier(2)->Range(1, 16);
@@ -0,0 +1,33 @@
+// The cost of the stats policy: the same list work with NoStats, which
+// should match a plain Yall, and with CountingStats.
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+  template<typename Stats>
+  using List = yall::Yall<int, std::allocator<int>, yall::UniqueOwnership,
+                          Stats>;
+
+  // fill, search from both ends, then empty from the front
+  template<typename Stats>
+  void BM_Workload(benchmark::State& state) {
+    const auto len = static_cast<int>(state.range(0));
+    for (auto _: state) {
+      List<Stats> list;
+      for (int i = 0; i < len; ++i) {
+        list.push_back(i);
+      }
+      for (int i = 0; i < 16; ++i) {
+        benchmark::DoNotOptimize(list.remove_first(len / 2 + i));
+        benchmark::DoNotOptimize(list.remove_last(len / 4 + i));
+      }
+      while (!list.empty()) {
+        list.pop_front();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * len);
+  }
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_Workload, yall::NoStats)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Workload, yall::CountingStats)->Range(1 << 10, 1 << 16);
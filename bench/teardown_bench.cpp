@@ -0,0 +1,53 @@
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+  template<typename List>
+  void fill(List& list, int64_t len) {
+    for (int64_t i = 0; i < len; ++i) {
+      list.push_back(static_cast<double>(i));
+    }
+  }
+
+  // time to destroy a list of state.range(0) nodes
+  template<typename List>
+  void BM_Teardown(benchmark::State& state) {
+    const auto len = state.range(0);
+    for (auto _: state) {
+      state.PauseTiming();
+      auto* list = new List;
+      fill(*list, len);
+      state.ResumeTiming();
+      delete list;
+    }
+    state.SetItemsProcessed(state.iterations() * len);
+  }
+
+  template<typename Ownership>
+  void BM_PoolTeardown(benchmark::State& state) {
+    const auto len = state.range(0);
+    yall::NodePool pool(1024);
+    for (auto _: state) {
+      state.PauseTiming();
+      auto* list = new yall::pmr::Yall<double, Ownership>(&pool);
+      fill(*list, len);
+      state.ResumeTiming();
+      delete list;
+    }
+    state.SetItemsProcessed(state.iterations() * len);
+  }
+}// namespace
+
+using SharedList = yall::Yall<double>;
+using UniqueList =
+        yall::Yall<double, std::allocator<double>, yall::UniqueOwnership>;
+
+BENCHMARK(BM_Teardown<SharedList>)->RangeMultiplier(16)->Range(16, 1 << 24);
+BENCHMARK(BM_Teardown<UniqueList>)->RangeMultiplier(16)->Range(16, 1 << 24);
+BENCHMARK(BM_PoolTeardown<yall::SharedOwnership>)
+        ->RangeMultiplier(16)
+        ->Range(16, 1 << 24);
+// bulk release path: trivially destructible payload, sole user of the pool
+BENCHMARK(BM_PoolTeardown<yall::UniqueOwnership>)
+        ->RangeMultiplier(16)
+        ->Range(16, 1 << 24);
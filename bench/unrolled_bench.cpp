@@ -0,0 +1,81 @@
+#include "yall.hpp"
+#include "yall_unrolled.hpp"
+#include <benchmark/benchmark.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+  using SharedList = yall::Yall<double>;
+  using UniqueList =
+          yall::Yall<double, std::allocator<double>, yall::UniqueOwnership>;
+  using Unrolled16 = yall::UnrolledYall<double, 16>;
+  using Unrolled64 = yall::UnrolledYall<double, 64>;
+
+  template<typename List>
+  void fill(List& list, int64_t len) {
+    for (int64_t i = 0; i < len; ++i) {
+      list.push_back(static_cast<double>(i));
+    }
+  }
+
+  // full front-to-back pass through the iterators
+  template<typename List>
+  void BM_Traverse(benchmark::State& state) {
+    List list;
+    fill(list, state.range(0));
+    for (auto _: state) {
+      double sum = 0;
+      for (auto d: list) {
+        sum += d;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  // linear search for a value that isn't there
+  template<typename List>
+  void BM_Search(benchmark::State& state) {
+    List list;
+    fill(list, state.range(0));
+    for (auto _: state) {
+      benchmark::DoNotOptimize(list.remove_first(-1.0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+#if defined(__GLIBC__)
+  // heap bytes per element, malloc overhead included, reported as a counter
+  template<typename List>
+  void BM_Memory(benchmark::State& state) {
+    std::size_t bytes = 0;
+    for (auto _: state) {
+      const auto before = mallinfo2().uordblks;
+      List list;
+      fill(list, state.range(0));
+      bytes = mallinfo2().uordblks - before;
+    }
+    state.counters["bytes_per_element"] =
+            static_cast<double>(bytes) / static_cast<double>(state.range(0));
+  }
+#endif
+}// namespace
+
+BENCHMARK(BM_Traverse<SharedList>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Traverse<UniqueList>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Traverse<Unrolled16>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Traverse<Unrolled64>)->Range(1 << 10, 1 << 22);
+
+BENCHMARK(BM_Search<SharedList>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Search<UniqueList>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Search<Unrolled16>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Search<Unrolled64>)->Range(1 << 10, 1 << 22);
+
+#if defined(__GLIBC__)
+BENCHMARK(BM_Memory<SharedList>)->Arg(1 << 16)->Iterations(1);
+BENCHMARK(BM_Memory<UniqueList>)->Arg(1 << 16)->Iterations(1);
+BENCHMARK(BM_Memory<Unrolled16>)->Arg(1 << 16)->Iterations(1);
+BENCHMARK(BM_Memory<Unrolled64>)->Arg(1 << 16)->Iterations(1);
+#endif
@@ -0,0 +1,100 @@
+// Whole-list traversal: a std::function callback per value, the way print()
+// works, against the inlined for_each, and formatting a report with a
+// std::function against write_to.
+#include "apps.hpp"
+#include "yall.hpp"
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <sstream>
+
+namespace {
+  using UniqueList =
+          yall::Yall<double, std::allocator<double>, yall::UniqueOwnership>;
+  using FooList = yall::Yall<yall::Foo, std::allocator<yall::Foo>,
+                             yall::UniqueOwnership>;
+
+  UniqueList doubles(int64_t n) {
+    UniqueList list;
+    for (int64_t i = 0; i < n; ++i) {
+      list.push_back(static_cast<double>(i) * 0.5);
+    }
+    return list;
+  }
+
+  void BM_SumStdFunction(benchmark::State& state) {
+    const auto list = doubles(state.range(0));
+    for (auto _: state) {
+      double sum = 0;
+      std::function<void(const double&)> cb = [&sum](const double& val) {
+        sum += val;
+      };
+      for (const double& val: list) {
+        cb(val);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_SumForEach(benchmark::State& state) {
+    const auto list = doubles(state.range(0));
+    for (auto _: state) {
+      double sum = 0;
+      list.for_each([&sum](double val) { sum += val; });
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_SumForEachReverse(benchmark::State& state) {
+    const auto list = doubles(state.range(0));
+    for (auto _: state) {
+      double sum = 0;
+      list.for_each_reverse([&sum](double val) { sum += val; });
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  FooList foos(int64_t n) {
+    FooList list;
+    for (int64_t i = 0; i < n; ++i) {
+      list.emplace_back("foo" + std::to_string(i % 1000),
+                        static_cast<int>(i));
+    }
+    return list;
+  }
+
+  void BM_ReportStdFunction(benchmark::State& state) {
+    const auto list = foos(state.range(0));
+    for (auto _: state) {
+      std::ostringstream os;
+      std::function<void(const yall::Foo&)> cb = [&os](const yall::Foo& foo) {
+        os << foo.name << ' ' << foo.id << '\n';
+      };
+      for (const auto& foo: list) {
+        cb(foo);
+      }
+      benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_ReportWriteTo(benchmark::State& state) {
+    const auto list = foos(state.range(0));
+    for (auto _: state) {
+      std::ostringstream os;
+      list.write_to(os, [](std::ostream& out, const yall::Foo& foo) {
+        out << foo.name << ' ' << foo.id << '\n';
+      });
+      benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}// namespace
+
+BENCHMARK(BM_SumStdFunction)->Arg(1 << 16);
+BENCHMARK(BM_SumForEach)->Arg(1 << 16);
+BENCHMARK(BM_SumForEachReverse)->Arg(1 << 16);
+BENCHMARK(BM_ReportStdFunction)->Arg(1 << 16);
+BENCHMARK(BM_ReportWriteTo)->Arg(1 << 16);
@@ -17,96 +17,734 @@
 #ifndef YALL_INCLUDE_YALL_HPP
 #define YALL_INCLUDE_YALL_HPP
 
+#include "yall_io.hpp"
+#include "yall_pool.hpp"
+#include "yall_stats.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+//! Number of nodes the scans of long lists (find, find_if, remove_first,
+//! for_each, ...) run ahead of the node being looked at, prefetching as they
+//! go, so the next node is on its way while the current one is examined.
+//! 0 turns prefetching off.
+#ifndef YALL_PREFETCH_DISTANCE
+#define YALL_PREFETCH_DISTANCE 4
+#endif
+
+//! Lists shorter than this are scanned without prefetching, they're likely
+//! to be in cache already.
+#ifndef YALL_PREFETCH_MIN_SIZE
+#define YALL_PREFETCH_MIN_SIZE 4096
+#endif
 
 namespace yall {
+  inline constexpr std::size_t prefetch_distance = YALL_PREFETCH_DISTANCE;
+  inline constexpr std::size_t prefetch_min_size = YALL_PREFETCH_MIN_SIZE;
+
+  namespace detail {
+    inline void prefetch([[maybe_unused]] const void* ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_prefetch(ptr);
+#endif
+    }
+
+    //! \return the NodePool behind a polymorphic allocator, or null
+    template<typename Alloc>
+    NodePool* node_pool_of(const Alloc& alloc) {
+      if constexpr (requires { alloc.resource(); }) {
+        return dynamic_cast<NodePool*>(alloc.resource());
+      } else {
+        return nullptr;
+      }
+    }
+  }// namespace detail
+
+  //! Ownership policy where each node is held by a shared pointer from its
+  //!  predecessor (or the list head) and refers back to it with a weak pointer.
+  //!  Every link change pays for atomic reference counting.
+  struct SharedOwnership {
+    static constexpr bool refcounted = true;
+
+    template<typename Node, typename NodeAlloc>
+    using Link = std::shared_ptr<Node>;
+    template<typename Node>
+    using BackLink = std::weak_ptr<Node>;
+
+    template<typename Node, typename NodeAlloc, typename... Args>
+    static Link<Node, NodeAlloc> make(const NodeAlloc& alloc, Args&&... args) {
+      return std::allocate_shared<Node>(alloc, std::forward<Args>(args)...);
+    }
+
+    template<typename Node>
+    static Node* get(const BackLink<Node>& link) {
+      return link.lock().get();
+    }
+
+    template<typename Node>
+    static BackLink<Node> back(const std::shared_ptr<Node>& link) {
+      return link;
+    }
+  };
+
+  //! Ownership policy where each node is the sole owner of its successor
+  //!  (a unique pointer) and refers back to its predecessor with a plain
+  //!  pointer. Nodes are still released automatically, but relinking and
+  //!  traversal are plain pointer moves.
+  struct UniqueOwnership {
+    static constexpr bool refcounted = false;
+
+    //! Returns a node to the allocator it came from.
+    template<typename NodeAlloc>
+    struct Deleter {
+      using traits = std::allocator_traits<NodeAlloc>;
+
+      Deleter() = default;
+      explicit Deleter(const NodeAlloc& alloc_) : alloc(alloc_) {}
+      Deleter(const Deleter&) = default;
+
+      // allocators such as std::pmr::polymorphic_allocator can't be assigned
+      Deleter& operator=(const Deleter& other) {
+        if constexpr (std::is_copy_assignable_v<NodeAlloc>) {
+          alloc = other.alloc;
+        } else if (this != &other) {
+          std::destroy_at(&alloc);
+          std::construct_at(&alloc, other.alloc);
+        }
+        return *this;
+      }
+
+      void operator()(typename traits::value_type* ptr) {
+        traits::destroy(alloc, ptr);
+        traits::deallocate(alloc, ptr, 1);
+      }
+
+      [[no_unique_address]] NodeAlloc alloc;
+    };
+
+    template<typename Node, typename NodeAlloc>
+    using Link = std::unique_ptr<Node, Deleter<NodeAlloc>>;
+    template<typename Node>
+    using BackLink = Node*;
+
+    template<typename Node, typename NodeAlloc, typename... Args>
+    static Link<Node, NodeAlloc> make(NodeAlloc alloc, Args&&... args) {
+      using traits = std::allocator_traits<NodeAlloc>;
+      Node* ptr    = traits::allocate(alloc, 1);
+      try {
+        traits::construct(alloc, ptr, std::forward<Args>(args)...);
+      } catch (...) {
+        traits::deallocate(alloc, ptr, 1);
+        throw;
+      }
+      return Link<Node, NodeAlloc>(ptr, Deleter<NodeAlloc>(alloc));
+    }
+
+    template<typename Node>
+    static Node* get(BackLink<Node> link) {
+      return link;
+    }
+
+    template<typename Node, typename NodeAlloc>
+    static BackLink<Node> back(const Link<Node, NodeAlloc>& link) {
+      return link.get();
+    }
+  };
 
   //! Generic doubly linked-list.
   //!  The implementation allows for "T" to be a reference type but this can
   //!  to undefined behavior if the list's reference outlives the client's
   //!  value that the reference refers to.
   //!
+  //!  Nodes are obtained through the allocator, which is rebound to the
+  //!  node type. Use yall::pmr::Yall with a yall::NodePool to recycle the
+  //!  nodes released by pop/remove calls instead of going back to the heap.
+  //!
+  //!  The ownership policy decides how nodes are linked, SharedOwnership
+  //!  (the default) or UniqueOwnership, which avoids all reference counting.
+  //!
+  //!  The stats policy is NoStats (the default), which costs nothing, or
+  //!  CountingStats to record what every operation did, see stats().
+  //!
   //!* \tparam T The type of the node data.
-  template<typename T>
+  //!* \tparam Alloc The allocator used for the nodes.
+  //!* \tparam Ownership How the nodes own each other.
+  //!* \tparam Stats What is recorded about the list's operations.
+  template<typename T, typename Alloc = std::allocator<std::decay_t<T>>,
+           typename Ownership = SharedOwnership, typename Stats = NoStats>
   class Yall final {
     /* getter functions further below require a non-reference type  */
     using DecayT = typename std::decay<T>::type;
 
+    struct Node;
+    using NodeAlloc =
+            typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using Link     = typename Ownership::template Link<Node, NodeAlloc>;
+    using BackLink = typename Ownership::template BackLink<Node>;
+
     struct Node {
-      explicit Node(const T& data_) : data(data_) {}
+      template<typename... Args>
+      explicit Node(std::in_place_t, Args&&... args)
+          : data(std::forward<Args>(args)...) {}
 
-      const T data;
-      std::weak_ptr<Node> prev;
-      std::shared_ptr<Node> next;
+      T data;
+      BackLink prev{};
+      Link next;
     };
-    using NodePtr = std::shared_ptr<Node>;
+
+    template<typename... Args>
+    Link make_node(Args&&... args) {
+      auto node = Ownership::template make<Node>(
+              NodeAlloc(alloc), std::in_place, std::forward<Args>(args)...);
+      if constexpr (Stats::enabled) {
+        counters.on_alloc();
+      }
+      return node;
+    }
+
+    // move the payload out of a node, unless it refers to the client's object
+    static decltype(auto) take(Node* node) {
+      if constexpr (std::is_reference_v<T>) {
+        return (node->data);
+      } else {
+        return std::move(node->data);
+      }
+    }
+
+    void note(Op op, size_t visited = 0) const {
+      if constexpr (Stats::enabled) {
+        counters.on_op(op, visited);
+      }
+    }
+
+    // with SharedOwnership, following a back link locks a weak pointer and
+    // making one bumps a weak count
+    void note_ref() const {
+      if constexpr (Stats::enabled && Ownership::refcounted) {
+        counters.on_ref_update();
+      }
+    }
+
+    Node* prev_of(const Node* node) const {
+      note_ref();
+      return Ownership::get(node->prev);
+    }
+
+    Node* tail_ptr() const {
+      note_ref();
+      return Ownership::get(tail);
+    }
+
+    template<typename L>
+    BackLink back_of(const L& link) const {
+      note_ref();
+      return Ownership::back(link);
+    }
+
+    // the link that holds on to the node, either the list head or the
+    // predecessor's next
+    Link& owner_of(Node* node) {
+      auto* prev_node = prev_of(node);
+      return prev_node ? prev_node->next : head;
+    }
+
+    Node* link_front(Link node) {
+      if (head) {
+        head->prev = back_of(node);
+        node->next = std::move(head);
+      } else {
+        tail = back_of(node);
+      }
+      head = std::move(node);
+      ++count;
+      return head.get();
+    }
+
+    Node* link_back(Link node) {
+      auto* ptr = node.get();
+      if (auto* old_tail = tail_ptr()) {
+        node->prev     = tail;
+        tail           = back_of(node);
+        old_tail->next = std::move(node);
+      } else {
+        tail = back_of(node);
+        head = std::move(node);
+      }
+      ++count;
+      return ptr;
+    }
+
+    // link a new node in front of pos
+    Node* link_before(Node* pos, Link node) {
+      Link& slot = owner_of(pos);
+      node->prev = pos->prev;
+      node->next = std::move(slot);
+      slot       = std::move(node);
+      pos->prev  = back_of(slot);
+      ++count;
+      return slot.get();
+    }
+
+    // link a new node behind pos
+    Node* link_after(Node* pos, Link node) {
+      node->prev = back_of(owner_of(pos));
+      node->next = std::move(pos->next);
+      pos->next  = std::move(node);
+      auto& ins  = pos->next;
+      if (ins->next) {
+        ins->next->prev = back_of(ins);
+      } else {
+        tail = back_of(ins);
+      }
+      ++count;
+      return ins.get();
+    }
+
+    // Call f with the nodes front to back until it returns true, visited is
+    // increased by the number of calls. On long lists a second pointer runs
+    // prefetch_distance nodes ahead, prefetching, which hides the memory
+    // latency when f has work of its own to do.
+    // \return the node f stopped at, or null
+    template<typename F>
+    Node* walk(F&& f, size_t& visited) const {
+      auto* ptr = head.get();
+      if constexpr (prefetch_distance > 0) {
+        if (count >= prefetch_min_size) {
+          auto* ahead = ptr;
+          for (size_t i = 0; ahead && i < prefetch_distance; ++i) {
+            ahead = ahead->next.get();
+          }
+          for (; ptr; ptr = ptr->next.get()) {
+            if (ahead) {
+              ahead = ahead->next.get();
+              detail::prefetch(ahead);
+            }
+            ++visited;
+            if (f(ptr)) {
+              return ptr;
+            }
+          }
+          return nullptr;
+        }
+      }
+      for (; ptr; ptr = ptr->next.get()) {
+        ++visited;
+        if (f(ptr)) {
+          return ptr;
+        }
+      }
+      return nullptr;
+    }
+
+    // walk back to front; only prefetches with plain back links, running
+    // ahead would double the weak pointer locks of SharedOwnership
+    template<typename F>
+    Node* rwalk(F&& f, size_t& visited) const {
+      auto* ptr = tail_ptr();
+      if constexpr (prefetch_distance > 0 && !Ownership::refcounted) {
+        if (count >= prefetch_min_size) {
+          auto* ahead = ptr;
+          for (size_t i = 0; ahead && i < prefetch_distance; ++i) {
+            ahead = Ownership::get(ahead->prev);
+          }
+          for (; ptr; ptr = Ownership::get(ptr->prev)) {
+            if (ahead) {
+              ahead = Ownership::get(ahead->prev);
+              detail::prefetch(ahead);
+            }
+            ++visited;
+            if (f(ptr)) {
+              return ptr;
+            }
+          }
+          return nullptr;
+        }
+      }
+      for (; ptr; ptr = prev_of(ptr)) {
+        ++visited;
+        if (f(ptr)) {
+          return ptr;
+        }
+      }
+      return nullptr;
+    }
+
+    // visited is increased by the number of nodes compared
+    Node* find_node(const T& match_val, size_t& visited) const {
+      return walk(
+              [&match_val](const Node* ptr) { return ptr->data == match_val; },
+              visited);
+    }
+
+    Node* rfind_node(const T& match_val, size_t& visited) const {
+      return rwalk(
+              [&match_val](const Node* ptr) { return ptr->data == match_val; },
+              visited);
+    }
+
+    // the node at indx, or null past the end of the list, visited is
+    // increased by the number of nodes stepped over
+    Node* node_at(size_t indx, size_t& visited) const {
+      auto* ptr = head.get();
+      while (ptr && indx--) {
+        ptr = ptr->next.get();
+        ++visited;
+      }
+      return ptr;
+    }
+
+    // unlink the nodes [first, last) without freeing them, the returned link
+    // owns the chain, chain_back is set to its last node
+    Link detach(Node* first, Node* last, Node*& chain_back) {
+      chain_back  = last ? prev_of(last) : tail_ptr();
+      Link& slot  = owner_of(first);
+      Link chain  = std::move(slot);
+      slot        = std::move(chain_back->next);
+      if (slot) {
+        slot->prev = first->prev;
+      } else {
+        tail = first->prev;
+      }
+      chain->prev = BackLink{};
+      return chain;
+    }
+
+    // link a detached chain in front of pos (at the back for null)
+    void attach(Node* pos, Link chain, Node* chain_back) {
+      if (pos) {
+        Link& slot       = owner_of(pos);
+        chain->prev      = pos->prev;
+        chain_back->next = std::move(slot);
+        slot             = std::move(chain);
+        pos->prev        = back_of(owner_of(chain_back));
+      } else {
+        auto* old_tail = tail_ptr();
+        chain->prev    = tail;
+        (old_tail ? old_tail->next : head) = std::move(chain);
+        tail = back_of(owner_of(chain_back));
+      }
+    }
+
+    // merge two sorted chains linked through next only, on ties the nodes
+    // of a come first
+    template<typename Compare>
+    static Link merge_chains(Link a, Link b, Compare& comp) {
+      Link result;
+      Link* out = &result;
+      while (a && b) {
+        Link& src = comp(b->data, a->data) ? b : a;
+        Link rest = std::move(src->next);
+        *out      = std::move(src);
+        src       = std::move(rest);
+        out       = &(*out)->next;
+      }
+      *out = std::move(a ? a : b);
+      return result;
+    }
+
+    // restore the back links (and tail) after relinking through next only
+    void relink_back() {
+      BackLink prev{};
+      for (Link* slot = &head; *slot; slot = &(*slot)->next) {
+        (*slot)->prev = prev;
+        prev          = back_of(*slot);
+      }
+      tail = prev;
+    }
+
+    // Build the nodes for the values in [first, last) as a detached chain
+    // (see attach), chain_back and n are set to its last node and length.
+    // A known length lets a NodePool carve the chain from one run of blocks.
+    template<typename It, typename S>
+    Link build_chain(It first, S last, size_t hint, Node*& chain_back,
+                     size_t& n) {
+      if (auto* pool = detail::node_pool_of(alloc); pool && hint > 1) {
+        pool->reserve_next(hint);
+      }
+      Link chain;
+      Link* slot = &chain;
+      BackLink prev{};
+      try {
+        for (; first != last; ++first) {
+          *slot         = make_node(*first);
+          (*slot)->prev = prev;
+          prev          = back_of(*slot);
+          chain_back    = slot->get();
+          slot          = &(*slot)->next;
+          ++n;
+        }
+      } catch (...) {
+        while (chain) {
+          chain = std::move(chain->next);
+        }
+        if constexpr (Stats::enabled) {
+          counters.on_free(n);
+        }
+        throw;
+      }
+      return chain;
+    }
+
+    // link new nodes for [first, last) in front of pos (at the back for
+    // null), the list is only touched once the chain is complete
+    // \return the first new node, or pos if the range was empty
+    template<typename It, typename S>
+    Node* insert_chain(Node* pos, It first, S last, size_t hint) {
+      Node* chain_back = nullptr;
+      size_t n         = 0;
+      Link chain = build_chain(std::move(first), std::move(last), hint,
+                               chain_back, n);
+      if (!chain) {
+        note(Op::insert_range);
+        return pos;
+      }
+      auto* front = chain.get();
+      attach(pos, std::move(chain), chain_back);
+      count += n;
+      note(Op::insert_range);
+      return front;
+    }
+
+    // n nodes of other have been relinked into this list
+    void transferred(Yall& other, size_t n) {
+      if constexpr (Stats::enabled) {
+        other.counters.on_transfer(-static_cast<std::ptrdiff_t>(n));
+        counters.on_transfer(static_cast<std::ptrdiff_t>(n));
+      }
+    }
+
+    // take over the nodes of other, which is left empty
+    void steal(Yall& other) noexcept {
+      head  = std::move(other.head);
+      tail  = std::exchange(other.tail, BackLink{});
+      count = std::exchange(other.count, 0);
+      transferred(other, count);
+    }
+
+    // Unlink, in one pass, every node doomed(node, kept) accepts, kept is
+    // the last node left in the list before it (null at the front). The
+    // nodes are freed, or moved to the back of removed, which can be this
+    // list.
+    // \return the number of nodes unlinked
+    template<typename F>
+    size_t remove_nodes(F&& doomed, Yall* removed, Op op) {
+      assert(!removed || removed->alloc == alloc);
+      if (removed == this) {
+        // set them aside while walking, then link them back in at the end
+        Yall moved(alloc);
+        const auto unlinked = remove_nodes(doomed, &moved, op);
+        if (moved.head) {
+          auto* chain_back = moved.tail_ptr();
+          count += std::exchange(moved.count, 0);
+          moved.tail = BackLink{};
+          attach(nullptr, std::move(moved.head), chain_back);
+          transferred(moved, unlinked);
+        }
+        return unlinked;
+      }
+      size_t unlinked = 0;
+      size_t visited  = 0;
+      Node* kept      = nullptr;
+      for (Link* slot = &head; *slot;) {
+        ++visited;
+        if (!doomed(slot->get(), kept)) {
+          kept = slot->get();
+          slot = &kept->next;
+          continue;
+        }
+        Link victim = std::move(*slot);
+        *slot       = std::move(victim->next);
+        if (*slot) {
+          (*slot)->prev = victim->prev;
+        } else {
+          tail = victim->prev;
+        }
+        --count;
+        ++unlinked;
+        if (removed) {
+          victim->prev = BackLink{};
+          removed->link_back(std::move(victim));
+          removed->transferred(*this, 1);
+        } else if constexpr (Stats::enabled) {
+          counters.on_free();
+        }
+      }
+      note(op, visited);
+      return unlinked;
+    }
+
+    // unlink and free the node
+    void unlink(Node* node) {
+      Link& slot  = owner_of(node);
+      Link victim = std::move(slot);
+      slot        = std::move(victim->next);
+      if (slot) {
+        slot->prev = victim->prev;
+      } else {
+        tail = victim->prev;
+      }
+      --count;
+      if constexpr (Stats::enabled) {
+        counters.on_free();
+      }
+    }
 
   public:
+    using allocator_type = Alloc;
+
     Yall()  = default;
-    ~Yall() = default;
+    ~Yall() { reset(); }
+
+    explicit Yall(const Alloc& alloc_) : alloc(alloc_) {}
+
+    //! Build a list from the values in [first, last), see insert_range.
+    template<std::input_iterator It, std::sentinel_for<It> S>
+    Yall(It first, S last, const Alloc& alloc_ = Alloc()) : alloc(alloc_) {
+      insert_range(cend(), std::move(first), std::move(last));
+    }
+
+    //! Build a list from the values of a range, see insert_range.
+    template<std::ranges::input_range R>
+      requires(!std::is_same_v<std::remove_cvref_t<R>, Yall>)
+    explicit Yall(R&& range, const Alloc& alloc_ = Alloc()) : alloc(alloc_) {
+      append_range(std::forward<R>(range));
+    }
 
     Yall(const Yall&)            = delete;
-    Yall(Yall&&)                 = delete;
     Yall& operator=(const Yall&) = delete;
-    Yall& operator=(Yall&&)      = delete;
+
+    //! The nodes are handed over, nothing is copied or reallocated.
+    Yall(Yall&& other) noexcept : alloc(other.alloc) { steal(other); }
+
+    //! The nodes are handed over if the allocators allow it (they propagate
+    //! or compare equal), otherwise the values are moved one by one into
+    //! nodes from this list's allocator.
+    Yall& operator=(Yall&& other) {
+      if (this == &other) {
+        return *this;
+      }
+      reset();
+      using traits = std::allocator_traits<Alloc>;
+      if constexpr (traits::propagate_on_container_move_assignment::value) {
+        alloc = other.alloc;
+        steal(other);
+      } else if (alloc == other.alloc) {
+        steal(other);
+      } else {
+        for (auto* ptr = other.head.get(); ptr; ptr = ptr->next.get()) {
+          emplace_back(take(ptr));
+        }
+        other.reset();
+      }
+      return *this;
+    }
 
     //! Insert a new node at the front of the list.
     //! \param data node value
     void push_front(const T& data) {
-      auto node_ptr = std::make_shared<Node>(data);
-      if (head) {
-        node_ptr->next = head;
-        head->prev     = node_ptr;
-        head           = node_ptr;
-      } else {
-        head = node_ptr;
-        tail = node_ptr;
-      }
+      link_front(make_node(data));
+      note(Op::push_front);
+    }
+
+    //! Insert a new node at the front of the list, moving the value in.
+    //! \param data node value
+    void push_front(DecayT&& data)
+      requires(!std::is_reference_v<T>)
+    {
+      link_front(make_node(std::move(data)));
+      note(Op::push_front);
+    }
+
+    //! Construct a new node value in place at the front of the list.
+    //! \param args arguments for the T constructor
+    //! \return the new value
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+      auto* ptr = link_front(make_node(std::forward<Args>(args)...));
+      note(Op::push_front);
+      return ptr->data;
     }
 
     //! Insert a new node at the back of the list.
     //! \param data node value
     void push_back(const T& data) {
-      auto node_ptr = std::make_shared<Node>(data);
-      if (auto old_tail = tail.lock()) {
-        node_ptr->prev = old_tail;
-        old_tail->next = node_ptr;
-        tail           = node_ptr;
-      } else {
-        head = node_ptr;
-        tail = node_ptr;
-      }
+      link_back(make_node(data));
+      note(Op::push_back);
+    }
+
+    //! Insert a new node at the back of the list, moving the value in.
+    //! \param data node value
+    void push_back(DecayT&& data)
+      requires(!std::is_reference_v<T>)
+    {
+      link_back(make_node(std::move(data)));
+      note(Op::push_back);
+    }
+
+    //! Construct a new node value in place at the back of the list.
+    //! \param args arguments for the T constructor
+    //! \return the new value
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+      auto* ptr = link_back(make_node(std::forward<Args>(args)...));
+      note(Op::push_back);
+      return ptr->data;
     }
 
     //! Removes the first element in the linked list
     void pop_front() {
       if (head) {
-        auto new_head = head->next;
-        if (new_head) {
-          head.reset();
-          head = new_head;
-        } else {
-          head.reset();
-          tail.reset();
-        }
+        unlink(head.get());
       }
+      note(Op::pop_front);
     }
 
     //! Removes the last element in the linked list.
     void pop_back() {
-      if (auto old_tail = tail.lock()) {
-        auto new_tail = old_tail->prev.lock();
-        if (new_tail) {
-          new_tail->next.reset();
-          tail = new_tail;
-        } else {
-          head.reset();
-          tail.reset();
-        }
+      if (auto* old_tail = tail_ptr()) {
+        unlink(old_tail);
       }
+      note(Op::pop_back);
+    }
+
+    //! Remove the first element, moving its value out (reference payloads
+    //! are copied, the client's object is left alone).
+    //!
+    //! \return the value that was at the front of the list, or none.
+    std::optional<DecayT> pop_front_value() {
+      note(Op::pop_front);
+      if (!head) {
+        return {};
+      }
+      std::optional<DecayT> val(take(head.get()));
+      unlink(head.get());
+      return val;
+    }
+
+    //! Remove the last element, moving its value out (reference payloads
+    //! are copied, the client's object is left alone).
+    //!
+    //! \return the value that was at the back of the list, or none.
+    std::optional<DecayT> pop_back_value() {
+      note(Op::pop_back);
+      auto* ptr = tail_ptr();
+      if (!ptr) {
+        return {};
+      }
+      std::optional<DecayT> val(take(ptr));
+      unlink(ptr);
+      return val;
     }
 
     //! This method will make a copy of the node data, which may be costly.
@@ -124,8 +762,8 @@ namespace yall {
     //!
     //! \return a copy of the value at the back of the list, or none.
     std::optional<DecayT> back_val() const {
-      if (auto sp = tail.lock()) {
-        DecayT val = sp->data;
+      if (auto* ptr = tail_ptr()) {
+        DecayT val = ptr->data;
         return val;
       }
       return {};
@@ -146,99 +784,136 @@ namespace yall {
     //! \param ref Output
     //! \return true if the list is not-empty and the reference has been assigned
     bool back(T& ref) const {
-      if (auto sp = tail.lock()) {
-        ref = sp->data;
+      if (auto* ptr = tail_ptr()) {
+        ref = ptr->data;
         return true;
       }
       return false;
     }
 
+    //! The value at the front of the list, without copying it. The list
+    //! must not be empty.
+    std::remove_reference_t<T>& front_ref() { return head->data; }
+    const DecayT& front_ref() const { return head->data; }
+
+    //! The value at the back of the list, without copying it. The list must
+    //! not be empty.
+    std::remove_reference_t<T>& back_ref() { return tail_ptr()->data; }
+    const DecayT& back_ref() const { return tail_ptr()->data; }
+
     //! Start from the front of the list, find the first match, and remove it.
     //! \param match_val
     //! \return true if the value was found and removed, otherwise false
     bool remove_first(const T& match_val) {
-      if (head) {
-        if (head->data == match_val) {
-          pop_front();
-          return true;
-        }
-        auto ptr = head->next;
-        while (ptr) {
-          if (ptr->data == match_val) {
-            if (ptr == tail.lock()) {
-              pop_back();
-              return true;
-            }
-            //
-            auto prev_node = ptr->prev.lock();
-            auto next_node = ptr->next;
-            ptr.reset();
-            prev_node->next = next_node;
-            next_node->prev = prev_node;
-            return true;
-          }
-          ptr = ptr->next;
-        }
+      size_t visited = 0;
+      auto* ptr      = find_node(match_val, visited);
+      if (ptr) {
+        unlink(ptr);
       }
-      return false;
+      note(Op::remove_first, visited);
+      return ptr != nullptr;
     }
 
     //! Start from the back of the list, find the first match, and remove it.
     //! \param match_val
     //! \return true if the value was found and removed, otherwise false
     bool remove_last(const T& match_val) {
-      if (auto sp = tail.lock()) {
-        if (sp->data == match_val) {
-          pop_back();
-          return true;
-        }
-        auto ptr = sp->prev;
-        while ((sp = ptr.lock())) {
-          if (sp->data == match_val) {
-            if (sp == head) {
-              pop_front();
-              return true;
-            }
-            auto prev_node = sp->prev.lock();
-            auto next_node = sp->next;
-            sp.reset();
-            prev_node->next = next_node;
-            next_node->prev = prev_node;
-            return true;
-          }
-          ptr = sp->prev;
-        }
+      size_t visited = 0;
+      auto* ptr      = rfind_node(match_val, visited);
+      if (ptr) {
+        unlink(ptr);
       }
-      return false;
+      note(Op::remove_last, visited);
+      return ptr != nullptr;
+    }
+
+    //! Remove every value pred accepts, in a single pass.
+    //! \return the number of values removed
+    template<typename Pred>
+    size_t remove_if(Pred pred) {
+      return remove_nodes(
+              [&pred](Node* node, Node*) { return pred(node->data); },
+              nullptr, Op::remove_if);
     }
 
+    //! Remove every value pred accepts, in a single pass, moving the nodes
+    //! to the back of removed (in order) instead of destroying them.
+    //! Nothing is copied or allocated, the allocators must compare equal.
+    //! removed can be this list, the nodes then end up at its back.
+    //! \return the number of values removed
+    template<typename Pred>
+    size_t remove_if(Pred pred, Yall& removed) {
+      return remove_nodes(
+              [&pred](Node* node, Node*) { return pred(node->data); },
+              &removed, Op::remove_if);
+    }
+
+    //! Remove every match, in a single pass.
+    //! \return the number of values removed
+    size_t remove_all(const T& match_val) {
+      return remove_if(
+              [&match_val](const DecayT& val) { return val == match_val; });
+    }
+
+    //! Remove every match, moving the nodes to removed, see remove_if.
+    //! \return the number of values removed
+    size_t remove_all(const T& match_val, Yall& removed) {
+      return remove_if(
+              [&match_val](const DecayT& val) { return val == match_val; },
+              removed);
+    }
+
+    //! Remove all but the first of every run of consecutive values pred
+    //! calls equal, in a single pass. pred gets the value kept and the
+    //! one after it. On a sorted list this leaves each value once.
+    //! \return the number of values removed
+    template<typename BinaryPred = std::equal_to<>>
+    size_t unique(BinaryPred pred = {}) {
+      return remove_nodes(
+              [&pred](Node* node, Node* kept) {
+                return kept && pred(kept->data, node->data);
+              },
+              nullptr, Op::unique);
+    }
+
+    //! Remove the consecutive duplicates, moving the nodes to removed, see
+    //! remove_if.
+    //! \return the number of values removed
+    template<typename BinaryPred>
+    size_t unique(BinaryPred pred, Yall& removed) {
+      return remove_nodes(
+              [&pred](Node* node, Node* kept) {
+                return kept && pred(kept->data, node->data);
+              },
+              &removed, Op::unique);
+    }
+
+    size_t unique(Yall& removed) { return unique(std::equal_to<>{}, removed); }
+
     //! Look for first occurrence of the match value, insert new value before that
     //! @param match_val
     //! @param new_val
     //! @return true if the new value has been inserted into the list
     bool insert_before(const T& match_val, const T& new_val) {
-      if (head) {
-        if (head->data == match_val) {
-          push_front(new_val);
-          return true;
-        }
-        auto ptr = head->next;
-        while (ptr) {
-          if (ptr->data == match_val) {
-            auto node_ptr   = std::make_shared<Node>(new_val);
-            auto prev_node  = ptr->prev.lock();
-            prev_node->next = node_ptr;
-            node_ptr->prev  = prev_node;
-
-            node_ptr->next = ptr;
-            ptr->prev      = node_ptr;
-
-            return true;
-          }
-          ptr = ptr->next;
-        }
+      size_t visited = 0;
+      auto* ptr      = find_node(match_val, visited);
+      if (ptr) {
+        link_before(ptr, make_node(new_val));
       }
-      return false;
+      note(Op::insert_before, visited);
+      return ptr != nullptr;
+    }
+
+    bool insert_before(const T& match_val, DecayT&& new_val)
+      requires(!std::is_reference_v<T>)
+    {
+      size_t visited = 0;
+      auto* ptr      = find_node(match_val, visited);
+      if (ptr) {
+        link_before(ptr, make_node(std::move(new_val)));
+      }
+      note(Op::insert_before, visited);
+      return ptr != nullptr;
     }
 
     //! Look for first occurrence of the match value, insert new value after that
@@ -246,147 +921,732 @@ namespace yall {
     //! @param new_val
     //! @return true if the new value has been inserted into the list
     bool insert_after(const T& match_val, const T& new_val) {
-      auto ptr = head;
-      while (ptr) {
-        if (ptr->data == match_val) {
-          if (ptr == tail.lock()) {
-            push_back(new_val);
-            return true;
-          }
-          auto node_ptr   = std::make_shared<Node>(new_val);
-          node_ptr->next  = ptr->next;
-          ptr->next->prev = node_ptr;
-          node_ptr->prev  = ptr;
-
-          ptr->next = node_ptr;
-
-          return true;
-        }
-        ptr = ptr->next;
+      size_t visited = 0;
+      auto* ptr      = find_node(match_val, visited);
+      if (ptr) {
+        link_after(ptr, make_node(new_val));
       }
-      return false;
+      note(Op::insert_after, visited);
+      return ptr != nullptr;
     }
 
-    void insert_at(size_t indx, const T& new_val) {
-      if (indx == 0) {
-        push_front(new_val);
-        return;
+    bool insert_after(const T& match_val, DecayT&& new_val)
+      requires(!std::is_reference_v<T>)
+    {
+      size_t visited = 0;
+      auto* ptr      = find_node(match_val, visited);
+      if (ptr) {
+        link_after(ptr, make_node(std::move(new_val)));
       }
-      size_t counter = 0;
+      note(Op::insert_after, visited);
+      return ptr != nullptr;
+    }
 
-      auto ptr = head;
-      while (ptr) {
-        if (counter++ == indx) {
-          insert_before(ptr->data, new_val);
-          return;
-        }
-        ptr = ptr->next;
+    //! Insert a new value so that it ends up at position indx, or at the back
+    //! of the list if indx is past the end.
+    void insert_at(size_t indx, const T& new_val) { emplace_at(indx, new_val); }
+
+    void insert_at(size_t indx, DecayT&& new_val)
+      requires(!std::is_reference_v<T>)
+    {
+      emplace_at(indx, std::move(new_val));
+    }
+
+    //! Construct a new value in place at position indx, or at the back of
+    //! the list if indx is past the end.
+    //! \param args arguments for the T constructor
+    //! \return the new value
+    template<typename... Args>
+    T& emplace_at(size_t indx, Args&&... args) {
+      auto node      = make_node(std::forward<Args>(args)...);
+      size_t visited = 0;
+      auto* pos      = node_at(indx, visited);
+      auto* ptr = pos ? link_before(pos, std::move(node))
+                      : link_back(std::move(node));
+      note(Op::insert_at, visited);
+      return ptr->data;
+    }
+
+    //! Call f with every value, front to back. The callback is inlined,
+    //! there is no std::function in the way. f must not add or remove
+    //! nodes. Long lists are prefetched ahead, see YALL_PREFETCH_DISTANCE.
+    //! \param f callable taking a value, a mutable one unless the list is
+    //!          const
+    template<typename F>
+    void for_each(F&& f) {
+      size_t visited = 0;
+      walk(
+              [&f](Node* ptr) {
+                f(ptr->data);
+                return false;
+              },
+              visited);
+      note(Op::for_each, visited);
+    }
+
+    template<typename F>
+    void for_each(F&& f) const {
+      size_t visited = 0;
+      walk(
+              [&f](Node* ptr) {
+                f(std::as_const(ptr->data));
+                return false;
+              },
+              visited);
+      note(Op::for_each, visited);
+    }
+
+    //! Call f with every value, back to front.
+    template<typename F>
+    void for_each_reverse(F&& f) {
+      size_t visited = 0;
+      rwalk(
+              [&f](Node* ptr) {
+                f(ptr->data);
+                return false;
+              },
+              visited);
+      note(Op::for_each, visited);
+    }
+
+    template<typename F>
+    void for_each_reverse(F&& f) const {
+      size_t visited = 0;
+      rwalk(
+              [&f](Node* ptr) {
+                f(std::as_const(ptr->data));
+                return false;
+              },
+              visited);
+      note(Op::for_each, visited);
+    }
+
+    //! Format the values into a stream, front to back, stopping if the
+    //! stream fails. Nothing is written between values, e.g.
+    //!  \code
+    //!  list.write_to(os, [](std::ostream& out, const Foo& foo) {
+    //!    out << foo.name << ' ' << foo.id << '\n';
+    //!  });
+    //!  \endcode
+    //! \param write callable taking the stream and a value
+    //! \return true if the stream is still good
+    template<typename F>
+    bool write_to(std::ostream& os, F&& write) const {
+      size_t visited = 0;
+      if (os) {
+        walk(
+                [&os, &write](Node* ptr) {
+                  write(os, std::as_const(ptr->data));
+                  return !os;
+                },
+                visited);
       }
-      push_back(new_val);
+      note(Op::for_each, visited);
+      return static_cast<bool>(os);
     }
 
     using PrinterCB = std::function<void(const T&)>;
 
     //! Print the values in the list, front-to-back.
+    //!  for_each and write_to do the same without a std::function call per
+    //!  value or the fixed output.
     //!
     //! \param printer_cb callback that will print node data to stdout
     void print(PrinterCB printer_cb) const {
-      auto ptr = head;
-      while (ptr) {
+      for (auto* ptr = head.get(); ptr; ptr = ptr->next.get()) {
         printer_cb(ptr->data);
-        ptr = ptr->next;
       }
       std::cout << "|-\n";// list display "null-terminator"
     }
 
+    //! Write the list to a binary stream, see yall_io.hpp for the format.
+    //!  The values are copied as bytes into a block buffer that is written
+    //!  out whenever it fills up. Values bigger than a block are written
+    //!  straight from their nodes.
+    //! \return true if everything was written
+    bool save(std::ostream& os) const
+      requires(std::is_trivially_copyable_v<T> && !std::is_reference_v<T>)
+    {
+      if (!io::write_header(os, io::Encoding::raw, sizeof(T), count)) {
+        return false;
+      }
+      if constexpr (sizeof(T) > io::block_bytes) {
+        for (auto* ptr = head.get(); ptr && os; ptr = ptr->next.get()) {
+          os.write(reinterpret_cast<const char*>(&ptr->data), sizeof(T));
+        }
+        return static_cast<bool>(os);
+      } else {
+        std::array<char, io::block_bytes> block;
+        size_t used = 0;
+        for (auto* ptr = head.get(); ptr; ptr = ptr->next.get()) {
+          if (used + sizeof(T) > block.size()) {
+            os.write(block.data(), static_cast<std::streamsize>(used));
+            used = 0;
+          }
+          std::memcpy(block.data() + used, &ptr->data, sizeof(T));
+          used += sizeof(T);
+        }
+        os.write(block.data(), static_cast<std::streamsize>(used));
+        return static_cast<bool>(os);
+      }
+    }
+
+    //! Write the list to a binary stream, each value written by the codec.
+    //! \return true if everything was written
+    template<io::Codec<DecayT> C>
+    bool save(std::ostream& os, C&& codec) const {
+      if (!io::write_header(os, io::Encoding::codec, 0, count)) {
+        return false;
+      }
+      for (auto* ptr = head.get(); ptr && os; ptr = ptr->next.get()) {
+        codec.write(os, ptr->data);
+      }
+      return static_cast<bool>(os);
+    }
+
+    //! Replace the values of the list with those written by save().
+    //!  Values are read a block at a time and linked in as a chain per
+    //!  block, nodes from a NodePool come from one run of blocks each time.
+    //!  Values bigger than a block are read one at a time.
+    //! \return false, leaving the list as it was, if the stream doesn't
+    //!         hold a list of this value type or ends early
+    bool load(std::istream& is)
+      requires(std::is_trivially_copyable_v<T> && !std::is_reference_v<T>)
+    {
+      const auto n = io::read_header(is, io::Encoding::raw, sizeof(T));
+      if (!n) {
+        return false;
+      }
+      Yall loaded(alloc);
+      if constexpr (sizeof(T) > io::block_bytes) {
+        // storage for one value on the heap, it would not fit in a block
+        struct Release {
+          void operator()(T* ptr) const {
+            std::allocator<T>().deallocate(ptr, 1);
+          }
+        };
+        std::unique_ptr<T, Release> val(std::allocator<T>().allocate(1));
+        for (auto left = *n; left > 0; --left) {
+          if (!is.read(reinterpret_cast<char*>(val.get()), sizeof(T))) {
+            return false;
+          }
+          const T* read = std::launder(val.get());
+          loaded.insert_chain(nullptr, read, read + 1, 1);
+        }
+        *this = std::move(loaded);
+        return true;
+      } else {
+        alignas(T) std::array<char, io::block_bytes> block;
+        constexpr size_t per_block = io::block_bytes / sizeof(T);
+        for (auto left = *n; left > 0;) {
+          const auto len = static_cast<size_t>(
+                  std::min<std::uint64_t>(left, per_block));
+          if (!is.read(block.data(),
+                       static_cast<std::streamsize>(len * sizeof(T)))) {
+            return false;
+          }
+          // reading into the buffer created the values (they are trivially
+          // copyable, so implicit-lifetime)
+          const T* vals =
+                  std::launder(reinterpret_cast<const T*>(block.data()));
+          loaded.insert_chain(nullptr, vals, vals + len, len);
+          left -= len;
+        }
+        *this = std::move(loaded);
+        return true;
+      }
+    }
+
+    //! Replace the values of the list with those written by save() with a
+    //! codec, each value is read by the codec and moved into a new node.
+    //! \return false, leaving the list as it was, if the stream doesn't
+    //!         hold a list written with a codec, ends early or the codec
+    //!         fails
+    template<io::Codec<DecayT> C>
+      requires(!std::is_reference_v<T>)
+    bool load(std::istream& is, C&& codec) {
+      const auto n = io::read_header(is, io::Encoding::codec, 0);
+      if (!n) {
+        return false;
+      }
+      Yall loaded(alloc);
+      for (auto left = *n; left > 0; --left) {
+        auto val = codec.read(is);
+        if (!val || !is) {
+          return false;
+        }
+        loaded.link_back(loaded.make_node(std::move(*val)));
+      }
+      *this = std::move(loaded);
+      return true;
+    }
+
     //! Free all nodes (create an empty list).
+    //!  Nodes are released one at a time from the front, so the stack depth
+    //!  doesn't grow with the length of the list.
+    //!  If the list is the only user of a NodePool, the payload is trivially
+    //!  destructible and the nodes are uniquely owned, there's nothing to run
+    //!  for each node and all of the pool's chunks are recycled at once. The
+    //!  list counts as the only user when every block the pool has handed
+    //!  out is of its node size, and there are as many as it has nodes.
     void reset() noexcept {
-      auto ptr = tail.lock();
-      while (ptr) {
-        if (ptr->next) {
-          ptr->next.reset();
+      if constexpr (Stats::enabled) {
+        // counted only, a throwing callback would terminate here
+        counters.on_free(count);
+        counters.count_op(Op::reset, count);
+      }
+      if constexpr (std::is_same_v<Ownership, UniqueOwnership> &&
+                    std::is_trivially_destructible_v<T>) {
+        auto* pool = detail::node_pool_of(alloc);
+        // nodes the pool passes upstream aren't counted, so the total alone
+        // could match with the blocks of another list
+        if (pool && count && pool->live_blocks() == count &&
+            pool->live_blocks(sizeof(Node), alignof(Node)) == count) {
+          (void) head.release();
+          pool->recycle_all();
         }
-        ptr = ptr->prev.lock();
       }
-      head.reset();
-      tail.reset();
+      while (head) {
+        head = std::move(head->next);
+      }
+      tail  = BackLink{};
+      count = 0;
     }
 
     //! \return whether the linked list is empty
-    bool empty() const { return !(head || tail.lock()); }
+    bool empty() const { return count == 0; }
+
+    allocator_type get_allocator() const { return alloc; }
 
+    //! \return the number of elements, kept up to date by every mutation
     size_t size() const {
-      size_t sz = 0;
-      auto ptr  = head;
-      while (ptr) {
-        ++sz;
-        ptr = ptr->next;
-      }
-      return sz;
+      note(Op::size);
+      return count;
+    }
+
+    //! \return a copy of everything recorded since the list was made or the
+    //!         stats were cleared, only with a stats policy such as
+    //!         CountingStats
+    StatsSnapshot stats() const
+      requires(Stats::enabled)
+    {
+      return counters.snapshot();
+    }
+
+    //! Call cb after every recorded operation, with the number of nodes the
+    //! operation visited. An empty callback removes it. reset() and the
+    //! destructor are noexcept, they are counted but cb isn't called for
+    //! them.
+    void set_stats_callback(StatsCallback cb)
+      requires(Stats::enabled)
+    {
+      counters.set_callback(std::move(cb));
+    }
+
+    //! Zero the recorded statistics, the live node count is kept.
+    void clear_stats()
+      requires(Stats::enabled)
+    {
+      counters.clear();
     }
 
   private:
-    NodePtr head;
-    std::weak_ptr<Node> tail;
+    [[no_unique_address]] Alloc alloc;
+    Link head;
+    BackLink tail{};
+    size_t count = 0;
+    [[no_unique_address]] mutable Stats counters;
 
   public:
-    struct ConstIterator {
+    //! Bidirectional iterator, stepping past either end gives the end
+    //! iterator (the same for both directions).
+    template<bool IsConst>
+    struct BasicIterator {
       // iterator traits
       using iterator_category = std::bidirectional_iterator_tag;
       using difference_type   = std::ptrdiff_t;// TODO is this correct?
       using value_type        = DecayT;
-      using pointer           = NodePtr;
-      using reference         = const DecayT&;
+      using pointer = std::conditional_t<IsConst, const DecayT*,
+                                         std::remove_reference_t<T>*>;
+      using reference = std::conditional_t<IsConst, const DecayT&,
+                                           std::remove_reference_t<T>&>;
 
-      explicit ConstIterator() : m_ptr(nullptr) {}
-      explicit ConstIterator(pointer ptr) : m_ptr(ptr) {}
-      explicit ConstIterator(std::weak_ptr<Node> ptr) : m_ptr(ptr.lock()) {}
+      explicit BasicIterator() : m_ptr(nullptr) {}
+
+      // a mutable iterator can be used where a const one is expected
+      template<bool OtherConst>
+        requires(IsConst && !OtherConst)
+      BasicIterator(const BasicIterator<OtherConst>& other)
+          : m_ptr(other.m_ptr) {}
 
       reference operator*() const { return m_ptr->data; }
-      pointer operator->() { return m_ptr; }
+      pointer operator->() const { return std::addressof(m_ptr->data); }
 
-      ConstIterator& operator++() {
-        m_ptr = m_ptr->next;
+      BasicIterator& operator++() {
+        m_ptr = m_ptr->next.get();
         return *this;
       }
 
-      ConstIterator operator++(int) {
-        ConstIterator tmp = *this;
+      BasicIterator operator++(int) {
+        BasicIterator tmp = *this;
         ++(*this);
         return tmp;
       }
 
-      ConstIterator& operator--() {
-        m_ptr = m_ptr->prev.lock();
+      BasicIterator& operator--() {
+        m_ptr = Ownership::get(m_ptr->prev);
         return *this;
       }
 
-      ConstIterator operator--(int) {
-        ConstIterator tmp = *this;
+      BasicIterator operator--(int) {
+        BasicIterator tmp = *this;
         --(*this);
         return tmp;
       }
 
-      friend bool operator==(const ConstIterator& a, const ConstIterator& b) {
+      friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
         return a.m_ptr == b.m_ptr;
       };
-      friend bool operator!=(const ConstIterator& a, const ConstIterator& b) {
+      friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
         return a.m_ptr != b.m_ptr;
       };
 
     private:
-      pointer m_ptr;
+      friend class Yall;
+      friend struct BasicIterator<!IsConst>;
+
+      explicit BasicIterator(Node* ptr) : m_ptr(ptr) {}
+
+      Node* m_ptr;
     };
 
-    ConstIterator cbegin() { return ConstIterator(head); }
-    ConstIterator cend() { return ConstIterator(); }
-    // allows range-based for loops with Yall containers
-    ConstIterator begin() { return cbegin(); }
-    ConstIterator end() { return cend(); }
+    using Iterator      = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    ConstIterator cbegin() const { return ConstIterator(head.get()); }
+    ConstIterator cend() const { return ConstIterator(); }
+    // allows range-based for loops with Yall containers, mutable ones
+    // unless the list is const
+    Iterator begin() { return Iterator(head.get()); }
+    Iterator end() { return Iterator(); }
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+
+    ConstIterator crbegin() const { return ConstIterator(tail_ptr()); }
+    ConstIterator crend() const { return ConstIterator(); }
+
+    //! Start from the front of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator find(const T& match_val) {
+      size_t visited = 0;
+      auto* ptr      = find_node(match_val, visited);
+      note(Op::find, visited);
+      return Iterator(ptr);
+    }
+
+    //! Start from the back of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator rfind(const T& match_val) {
+      size_t visited = 0;
+      auto* ptr      = rfind_node(match_val, visited);
+      note(Op::rfind, visited);
+      return Iterator(ptr);
+    }
+
+    //! Start from the front of the list and find the first value pred
+    //! accepts.
+    //! \return an iterator to the match, or the end iterator
+    template<typename Pred>
+    Iterator find_if(Pred&& pred) {
+      size_t visited = 0;
+      auto* ptr =
+              walk([&pred](Node* node) { return pred(node->data); }, visited);
+      note(Op::find, visited);
+      return Iterator(ptr);
+    }
+
+    template<typename Pred>
+    ConstIterator find_if(Pred&& pred) const {
+      size_t visited = 0;
+      auto* ptr      = walk(
+              [&pred](Node* node) { return pred(std::as_const(node->data)); },
+              visited);
+      note(Op::find, visited);
+      return ConstIterator(ptr);
+    }
+
+    //! Call pred with the values, front to back, until it returns true.
+    //! \return an iterator to the value pred stopped at, or the end iterator
+    template<typename Pred>
+    Iterator visit_until(Pred&& pred) {
+      size_t visited = 0;
+      auto* ptr =
+              walk([&pred](Node* node) { return pred(node->data); }, visited);
+      note(Op::visit_until, visited);
+      return Iterator(ptr);
+    }
+
+    template<typename Pred>
+    ConstIterator visit_until(Pred&& pred) const {
+      size_t visited = 0;
+      auto* ptr      = walk(
+              [&pred](Node* node) { return pred(std::as_const(node->data)); },
+              visited);
+      note(Op::visit_until, visited);
+      return ConstIterator(ptr);
+    }
+
+    //! Insert a new value in front of pos (at the back for the end iterator).
+    //! \return an iterator to the new value
+    Iterator insert(ConstIterator pos, const T& new_val) {
+      return emplace(pos, new_val);
+    }
+
+    Iterator insert(ConstIterator pos, DecayT&& new_val)
+      requires(!std::is_reference_v<T>)
+    {
+      return emplace(pos, std::move(new_val));
+    }
+
+    //! Construct a new value in place in front of pos (at the back for the
+    //! end iterator).
+    //! \return an iterator to the new value
+    template<typename... Args>
+    Iterator emplace(ConstIterator pos, Args&&... args) {
+      auto node = make_node(std::forward<Args>(args)...);
+      auto* ptr = pos.m_ptr ? link_before(pos.m_ptr, std::move(node))
+                            : link_back(std::move(node));
+      note(Op::insert);
+      return Iterator(ptr);
+    }
+
+    //! Remove the value at pos, which must be dereferenceable.
+    //! \return an iterator to the value that followed the removed one
+    Iterator erase(ConstIterator pos) {
+      auto* next_node = pos.m_ptr->next.get();
+      unlink(pos.m_ptr);
+      note(Op::erase);
+      return Iterator(next_node);
+    }
+
+    //! Remove the values in [first, last).
+    //! \return last
+    Iterator erase(ConstIterator first, ConstIterator last) {
+      while (first != last) {
+        first = erase(first);
+      }
+      return Iterator(last.m_ptr);
+    }
+
+    //! Insert the values in [first, last) in front of pos (at the back for
+    //! the end iterator).
+    //!  The new nodes are chained together on the side and linked into the
+    //!  list with a constant number of pointer updates. If the length of the
+    //!  range is known up front and the nodes come from a NodePool, they are
+    //!  carved from one contiguous run of blocks.
+    //! \return an iterator to the first new value, or pos for an empty range
+    template<std::input_iterator It, std::sentinel_for<It> S>
+    Iterator insert_range(ConstIterator pos, It first, S last) {
+      size_t hint = 0;
+      if constexpr (std::sized_sentinel_for<S, It>) {
+        hint = static_cast<size_t>(last - first);
+      }
+      return Iterator(
+              insert_chain(pos.m_ptr, std::move(first), std::move(last), hint));
+    }
+
+    //! Insert the values of a range in front of pos, see above.
+    template<std::ranges::input_range R>
+    Iterator insert_range(ConstIterator pos, R&& range) {
+      size_t hint = 0;
+      if constexpr (std::ranges::sized_range<R>) {
+        hint = static_cast<size_t>(std::ranges::size(range));
+      }
+      return Iterator(insert_chain(pos.m_ptr, std::ranges::begin(range),
+                                   std::ranges::end(range), hint));
+    }
+
+    //! Insert the values of a range at the back of the list.
+    template<std::ranges::input_range R>
+    void append_range(R&& range) {
+      insert_range(cend(), std::forward<R>(range));
+    }
+
+    //! Insert the values of a range at the front of the list, in order.
+    template<std::ranges::input_range R>
+    void prepend_range(R&& range) {
+      insert_range(cbegin(), std::forward<R>(range));
+    }
+
+    //! Move all the nodes of other in front of pos, in O(1).
+    //! Nothing is copied or allocated, the allocators must compare equal.
+    void splice(ConstIterator pos, Yall& other) {
+      assert(other.alloc == alloc);
+      if (this == &other || !other.head) {
+        note(Op::splice);
+        return;
+      }
+      auto* chain_back = other.tail_ptr();
+      auto moved       = std::exchange(other.count, 0);
+      Link chain       = std::move(other.head);
+      other.tail       = BackLink{};
+      attach(pos.m_ptr, std::move(chain), chain_back);
+      count += moved;
+      transferred(other, moved);
+      note(Op::splice);
+    }
+
+    void splice(ConstIterator pos, Yall&& other) { splice(pos, other); }
+
+    //! Move the node at it, which belongs to other, in front of pos, in O(1).
+    //! The allocators must compare equal.
+    void splice(ConstIterator pos, Yall& other, ConstIterator it) {
+      assert(other.alloc == alloc);
+      auto* node = it.m_ptr;
+      if (pos.m_ptr == node || (this == &other && pos.m_ptr == node->next.get())) {
+        note(Op::splice);
+        return;
+      }
+      Node* chain_back = nullptr;
+      Link chain = other.detach(node, node->next.get(), chain_back);
+      --other.count;
+      attach(pos.m_ptr, std::move(chain), chain_back);
+      ++count;
+      if (this != &other) {
+        transferred(other, 1);
+      }
+      note(Op::splice);
+    }
+
+    void splice(ConstIterator pos, Yall&& other, ConstIterator it) {
+      splice(pos, other, it);
+    }
+
+    //! Move the node at pos, which must be dereferenceable, to the front of
+    //! the list, in O(1). The same as a splice to the front, but only the
+    //! node itself and the list head are read, its neighbours are written
+    //! to. Recency lists (see LruCache) do this on every hit.
+    void move_to_front(ConstIterator pos) {
+      auto* node = pos.m_ptr;
+      if (node == head.get()) {
+        note(Op::splice);
+        return;
+      }
+      Link& slot  = prev_of(node)->next;
+      Link& after = node->next;
+      if (after) {
+        after->prev = node->prev;
+      } else {
+        tail = node->prev;
+      }
+      head->prev = back_of(slot);
+      node->prev = BackLink{};
+      // rotate the links: slot takes after, after takes head, head takes
+      // the node slot held
+      std::swap(slot, after);
+      std::swap(after, head);
+      note(Op::splice);
+    }
 
-    ConstIterator crbegin() { return ConstIterator(tail); }
-    ConstIterator crend() { return ConstIterator(); }
+    //! Move the nodes [first, last) of other in front of pos, pos must not be
+    //! in that range. The nodes are relinked at the ends only, but a range
+    //! from another list is walked once to keep the sizes up to date. The
+    //! allocators must compare equal.
+    void splice(ConstIterator pos, Yall& other, ConstIterator first,
+                ConstIterator last) {
+      assert(other.alloc == alloc);
+      if (first == last) {
+        note(Op::splice);
+        return;
+      }
+      size_t moved = 0;
+      if (this != &other) {
+        for (auto it = first; it != last; ++it) {
+          ++moved;
+        }
+        other.count -= moved;
+        count += moved;
+        transferred(other, moved);
+      }
+      Node* chain_back = nullptr;
+      Link chain = other.detach(first.m_ptr, last.m_ptr, chain_back);
+      attach(pos.m_ptr, std::move(chain), chain_back);
+      note(Op::splice, moved);
+    }
+
+    void splice(ConstIterator pos, Yall&& other, ConstIterator first,
+                ConstIterator last) {
+      splice(pos, other, first, last);
+    }
+
+    //! Merge the nodes of other into this list, both lists must be sorted.
+    //! The merge is stable and other is left empty.
+    //! Nothing is copied or allocated, the allocators must compare equal.
+    template<typename Compare = std::less<>>
+    void merge(Yall& other, Compare comp = {}) {
+      assert(other.alloc == alloc);
+      if (this == &other || !other.head) {
+        note(Op::merge);
+        return;
+      }
+      head = merge_chains(std::move(head), std::move(other.head), comp);
+      const auto moved = std::exchange(other.count, 0);
+      count += moved;
+      other.tail = BackLink{};
+      relink_back();
+      transferred(other, moved);
+      note(Op::merge, count);
+    }
+
+    template<typename Compare = std::less<>>
+    void merge(Yall&& other, Compare comp = {}) {
+      merge(other, comp);
+    }
+
+    //! Stable sort that relinks the nodes, values are never copied or moved
+    //! and nothing is allocated.
+    //! Bottom-up merge sort, O(n log n) comparisons.
+    template<typename Compare = std::less<>>
+    void sort(Compare comp = {}) {
+      if (count < 2) {
+        note(Op::sort, count);
+        return;
+      }
+      // bins[i] holds a sorted run of 2^i nodes (or nothing), earlier nodes
+      // sit in higher bins
+      Link bins[64];
+      size_t fill = 0;
+      while (head) {
+        Link carry = std::move(head);
+        head       = std::move(carry->next);
+        size_t i   = 0;
+        for (; bins[i]; ++i) {
+          carry = merge_chains(std::move(bins[i]), std::move(carry), comp);
+        }
+        bins[i] = std::move(carry);
+        if (i == fill) {
+          ++fill;
+        }
+      }
+      for (size_t i = 0; i < fill; ++i) {
+        head = merge_chains(std::move(bins[i]), std::move(head), comp);
+      }
+      relink_back();
+      note(Op::sort, count);
+    }
   };
+
+  namespace pmr {
+    //! Yall using a polymorphic allocator, e.g. one backed by a yall::NodePool
+    //!  \code
+    //!  yall::NodePool pool;
+    //!  yall::pmr::Yall<double> dlist(&pool);
+    //!  \endcode
+    template<typename T, typename Ownership = SharedOwnership,
+             typename Stats = NoStats>
+    using Yall = yall::Yall<T, std::pmr::polymorphic_allocator<std::decay_t<T>>,
+                            Ownership, Stats>;
+  }// namespace pmr
 }// namespace yall
 
 
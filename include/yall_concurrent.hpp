@@ -0,0 +1,299 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_CONCURRENT_HPP
+#define YALL_INCLUDE_YALL_CONCURRENT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace yall {
+  namespace detail {
+    //! Hazard pointers for the nodes of one lock-free container.
+    //!  A thread claims a record for the duration of an operation and
+    //!  publishes the nodes it is about to dereference in the record's slots.
+    //!  Unlinked nodes are retired to the record and only deleted once no
+    //!  slot of any record refers to them.
+    //!
+    //!  Records are never freed before the domain, so scanning them needs no
+    //!  synchronisation beyond the slot loads.
+    template<typename Node, std::size_t Slots = 2>
+    class HazardDomain {
+    public:
+      struct alignas(64) Record {
+        std::atomic<Node*> slots[Slots]{};
+        std::atomic<bool> active{true};
+        Record* next = nullptr;
+        // only touched by the thread that has claimed the record
+        std::vector<Node*> retired;
+      };
+
+      //! Claims a record for the current thread, releases it on destruction.
+      class Guard {
+      public:
+        explicit Guard(HazardDomain& domain_)
+            : domain(domain_), rec(domain_.acquire()) {}
+        ~Guard() { domain.release(rec); }
+
+        Guard(const Guard&)            = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        //! Load src and publish it in the slot, repeating until the published
+        //! pointer is known to be still reachable from src.
+        Node* protect(std::size_t slot, const std::atomic<Node*>& src) {
+          Node* ptr = src.load(std::memory_order_relaxed);
+          for (;;) {
+            rec->slots[slot].store(ptr, std::memory_order_seq_cst);
+            Node* again = src.load(std::memory_order_seq_cst);
+            if (again == ptr) {
+              return ptr;
+            }
+            ptr = again;
+          }
+        }
+
+        //! Hand over an unlinked node, it's deleted once it's unprotected.
+        void retire(Node* node) {
+          rec->retired.push_back(node);
+          if (rec->retired.size() >= domain.scan_threshold()) {
+            domain.scan(*rec);
+          }
+        }
+
+      private:
+        HazardDomain& domain;
+        Record* rec;
+      };
+
+      HazardDomain() = default;
+      ~HazardDomain() {
+        auto* rec = records.load(std::memory_order_acquire);
+        while (rec) {
+          auto* next = rec->next;
+          for (auto* node: rec->retired) {
+            delete node;
+          }
+          delete rec;
+          rec = next;
+        }
+      }
+
+      HazardDomain(const HazardDomain&)            = delete;
+      HazardDomain& operator=(const HazardDomain&) = delete;
+
+    private:
+      Record* acquire() {
+        for (auto* rec = records.load(std::memory_order_acquire); rec;
+             rec       = rec->next) {
+          if (!rec->active.load(std::memory_order_relaxed) &&
+              !rec->active.exchange(true, std::memory_order_acquire)) {
+            return rec;
+          }
+        }
+        auto* rec = new Record;
+        rec->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(rec->next, rec,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+        }
+        n_records.fetch_add(1, std::memory_order_relaxed);
+        return rec;
+      }
+
+      void release(Record* rec) {
+        for (auto& slot: rec->slots) {
+          slot.store(nullptr, std::memory_order_release);
+        }
+        rec->active.store(false, std::memory_order_release);
+      }
+
+      // amortises a scan over as many retired nodes as there can be hazards
+      std::size_t scan_threshold() const {
+        return 2 * Slots * n_records.load(std::memory_order_relaxed) + 64;
+      }
+
+      void scan(Record& owner) {
+        std::vector<Node*> hazards;
+        for (auto* rec = records.load(std::memory_order_acquire); rec;
+             rec       = rec->next) {
+          for (auto& slot: rec->slots) {
+            if (auto* ptr = slot.load(std::memory_order_seq_cst)) {
+              hazards.push_back(ptr);
+            }
+          }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto keep = std::partition(
+                owner.retired.begin(), owner.retired.end(), [&](Node* node) {
+                  return std::binary_search(hazards.begin(), hazards.end(),
+                                            node);
+                });
+        for (auto it = keep; it != owner.retired.end(); ++it) {
+          delete *it;
+        }
+        owner.retired.erase(keep, owner.retired.end());
+      }
+
+      std::atomic<Record*> records{nullptr};
+      std::atomic<std::size_t> n_records{0};
+    };
+  }// namespace detail
+
+  //! Lock-free multi-producer multi-consumer FIFO queue.
+  //!  This is the Michael-Scott queue: a singly linked list with a dummy node
+  //!  at the head, producers append with push_back and consumers take values
+  //!  from the front with try_pop_front. Nodes are reclaimed with hazard
+  //!  pointers, so a consumer never touches freed memory and there is no ABA
+  //!  problem.
+  //!
+  //!  All members except the destructor can be called concurrently. empty()
+  //!  is only a snapshot. Only value types can be stored.
+  //!
+  //!* \tparam T The type of the node data.
+  template<typename T>
+  class ConcurrentYall final {
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "ConcurrentYall stores values, use Yall for references");
+
+    struct Node {
+      Node() = default;
+      template<class... Args>
+      explicit Node(std::in_place_t, Args&&... args)
+          : data(std::in_place, std::forward<Args>(args)...) {}
+
+      std::optional<T> data;
+      std::atomic<Node*> next{nullptr};
+    };
+    using Domain = detail::HazardDomain<Node>;
+
+    void link_back(Node* node) {
+      typename Domain::Guard guard(hazards);
+      for (;;) {
+        Node* last = guard.protect(0, tail);
+        Node* next = last->next.load(std::memory_order_acquire);
+        if (last != tail.load(std::memory_order_acquire)) {
+          continue;
+        }
+        if (next) {
+          // another producer is half way through, help it along
+          tail.compare_exchange_weak(last, next, std::memory_order_release,
+                                     std::memory_order_relaxed);
+          continue;
+        }
+        if (last->next.compare_exchange_weak(next, node,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+          tail.compare_exchange_strong(last, node, std::memory_order_release,
+                                       std::memory_order_relaxed);
+          return;
+        }
+      }
+    }
+
+  public:
+    ConcurrentYall() : head(new Node), tail(head.load()) {}
+    ~ConcurrentYall() {
+      auto* node = head.load(std::memory_order_relaxed);
+      while (node) {
+        auto* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+      }
+    }
+
+    ConcurrentYall(const ConcurrentYall&)            = delete;
+    ConcurrentYall& operator=(const ConcurrentYall&) = delete;
+
+    //! Append a value at the back of the queue.
+    //! \param data node value
+    void push_back(const T& data) { emplace_back(data); }
+
+    //! Append a value at the back of the queue, moving it in.
+    //! \param data node value
+    void push_back(T&& data) { emplace_back(std::move(data)); }
+
+    //! Construct a value in place at the back of the queue.
+    //! \param args arguments for the T constructor
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+      link_back(new Node(std::in_place, std::forward<Args>(args)...));
+    }
+
+    //! Remove the first element, moving its value out.
+    //!  If the move throws, the exception propagates and the value is lost,
+    //!  it has already left the queue.
+    //!
+    //! \return the value that was at the front of the queue, or none if the
+    //!         queue was empty.
+    std::optional<T> try_pop_front() {
+      typename Domain::Guard guard(hazards);
+      for (;;) {
+        Node* first = guard.protect(0, head);
+        Node* last  = tail.load(std::memory_order_acquire);
+        Node* next  = guard.protect(1, first->next);
+        if (first != head.load(std::memory_order_acquire)) {
+          continue;
+        }
+        if (!next) {
+          return std::nullopt;
+        }
+        if (first == last) {
+          // the tail lags behind, help the producer that linked next
+          tail.compare_exchange_weak(last, next, std::memory_order_release,
+                                     std::memory_order_relaxed);
+          continue;
+        }
+        if (head.compare_exchange_weak(first, next, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed)) {
+          // slot 0 keeps first alive until the guard goes, retiring it
+          // before the move means a throwing move can't leak it
+          guard.retire(first);
+          // next is the new dummy, only the consumer that unlinked first
+          // touches its value and slot 1 keeps it alive meanwhile
+          std::optional<T> result(std::in_place, std::move(*next->data));
+          next->data.reset();
+          return result;
+        }
+      }
+    }
+
+    //! Removes the first element, if there is one.
+    //! \return false if the queue was empty.
+    bool pop_front() { return try_pop_front().has_value(); }
+
+    //! \return whether the queue was empty at the time of the call
+    bool empty() const {
+      typename Domain::Guard guard(hazards);
+      return guard.protect(0, head)->next.load(std::memory_order_acquire) ==
+             nullptr;
+    }
+
+  private:
+    // each on its own cache line, producers and consumers don't share them
+    alignas(64) std::atomic<Node*> head;
+    alignas(64) std::atomic<Node*> tail;
+    mutable Domain hazards;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_CONCURRENT_HPP
@@ -0,0 +1,374 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_FINELOCK_HPP
+#define YALL_INCLUDE_YALL_FINELOCK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace yall {
+
+  //! Doubly linked-list for concurrent edits anywhere in the list.
+  //!  Every node has its own mutex. Searches move along the list with lock
+  //!  coupling (hand-over-hand): the next node is locked before the current
+  //!  one is released, and an edit holds only the nodes it relinks, so edits
+  //!  in different parts of the list run in parallel. Locks are always taken
+  //!  front to back, which rules out deadlocks.
+  //!
+  //!  Nodes are shared pointers like in Yall's SharedOwnership, which is what
+  //!  lets an iterator keep its node alive without holding any lock: readers
+  //!  never block editors, and they see a weakly consistent view (an element
+  //!  linked in behind an iterator's position may be skipped, an element
+  //!  removed after the iterator got to it may still be visited).
+  //!
+  //!  Values are never modified once they are in the list, reads through an
+  //!  iterator and front_val/back_val copies are race free. All members except
+  //!  the destructor can be called concurrently. Only value types can be
+  //!  stored.
+  //!
+  //!* \tparam T The type of the node data.
+  template<typename T>
+  class FineLockYall final {
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "FineLockYall stores values, use Yall for references");
+
+    struct Node : std::enable_shared_from_this<Node> {
+      Node() = default;
+      template<class... Args>
+      explicit Node(std::in_place_t, Args&&... args)
+          : data(std::in_place, std::forward<Args>(args)...) {}
+
+      std::optional<T> data;// empty for the two sentinels
+      mutable std::mutex mtx;
+      std::weak_ptr<Node> prev;
+      std::shared_ptr<Node> next;// kept when unlinked, for iterators
+      bool unlinked = false;
+      Node* deferred = nullptr;// next node waiting in release()
+    };
+    using NodePtr = std::shared_ptr<Node>;
+    using Lock    = std::unique_lock<std::mutex>;
+
+    // Deleter of the element nodes. Unlinked nodes keep their next, so an
+    // iterator can pin a whole run of removed nodes, and letting it go would
+    // free the run through nested destructors. A node whose release is
+    // already running on this thread only queues the ones it frees, and that
+    // outer release deletes them in a loop.
+    static void release(Node* node) noexcept {
+      thread_local Node* pending = nullptr;
+      thread_local bool releasing = false;
+      node->deferred = pending;
+      pending        = node;
+      if (releasing) {
+        return;
+      }
+      releasing = true;
+      while (pending) {
+        auto* next = std::exchange(pending, pending->deferred);
+        delete next;
+      }
+      releasing = false;
+    }
+
+    template<class... Args>
+    static NodePtr make_node(Args&&... args) {
+      // if the control block can't be allocated, release frees the node
+      return NodePtr(new Node(std::in_place, std::forward<Args>(args)...),
+                     &release);
+    }
+
+    static NodePtr prev_of(const NodePtr& node) {
+      std::lock_guard lock(node->mtx);
+      return node->prev.lock();
+    }
+
+    // Pred and succ are locked and adjacent. A locked node can't be
+    // unlinked, and unlinking its successor needs its lock too, so raw
+    // pointers to locked nodes stay valid.
+    void link(Node* pred, NodePtr node, Node* succ) {
+      node->prev = pred->weak_from_this();
+      node->next = std::move(pred->next);
+      succ->prev = node;
+      pred->next = std::move(node);
+      count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Pred, node and succ are locked and adjacent. Returns the list's
+    // reference to node, the caller has to keep it until node is unlocked.
+    [[nodiscard]] NodePtr unlink(Node* pred, Node* node, Node* succ) {
+      NodePtr removed = std::move(pred->next);
+      succ->prev      = node->prev;
+      pred->next      = node->next;
+      node->unlinked  = true;
+      count.fetch_sub(1, std::memory_order_relaxed);
+      return removed;
+    }
+
+    // Walks the list with lock coupling until match accepts a value, then
+    // calls act(pred, node) with both nodes locked.
+    template<typename Match, typename Act>
+    bool find_locked(Match&& match, Act&& act) const {
+      Node* pred = head.get();
+      Lock pred_lock(pred->mtx);
+      Node* node = pred->next.get();
+      Lock node_lock(node->mtx);
+      while (node != tail.get()) {
+        if (match(*node->data)) {
+          act(pred, node);
+          return true;
+        }
+        pred      = node;
+        pred_lock = std::move(node_lock);
+        node      = pred->next.get();
+        node_lock = Lock(node->mtx);
+      }
+      return false;
+    }
+
+  public:
+    FineLockYall() {
+      head->next = tail;
+      tail->prev = head;
+    }
+    ~FineLockYall() {
+      // iterative, like Yall, so long lists don't recurse
+      auto node = std::move(head->next);
+      while (node) {
+        node = std::move(node->next);
+      }
+    }
+
+    FineLockYall(const FineLockYall&)            = delete;
+    FineLockYall& operator=(const FineLockYall&) = delete;
+
+    //! Insert a new node at the front of the list.
+    //! \param data node value
+    void push_front(const T& data) { emplace_front(data); }
+
+    //! Insert a new node at the front of the list, moving the value in.
+    //! \param data node value
+    void push_front(T&& data) { emplace_front(std::move(data)); }
+
+    //! Construct a new node value in place at the front of the list.
+    //! \param args arguments for the T constructor
+    template<class... Args>
+    void emplace_front(Args&&... args) {
+      auto node = make_node(std::forward<Args>(args)...);
+      Lock pred_lock(head->mtx);
+      Node* succ = head->next.get();
+      Lock succ_lock(succ->mtx);
+      link(head.get(), std::move(node), succ);
+    }
+
+    //! Insert a new node at the back of the list.
+    //! \param data node value
+    void push_back(const T& data) { emplace_back(data); }
+
+    //! Insert a new node at the back of the list, moving the value in.
+    //! \param data node value
+    void push_back(T&& data) { emplace_back(std::move(data)); }
+
+    //! Construct a new node value in place at the back of the list.
+    //! \param args arguments for the T constructor
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+      auto node = make_node(std::forward<Args>(args)...);
+      for (;;) {
+        // the last node can't be locked before the tail without breaking the
+        // lock order, so read it first and check it's still the last node
+        NodePtr pred = prev_of(tail);
+        Lock pred_lock(pred->mtx);
+        Lock tail_lock(tail->mtx);
+        if (!pred->unlinked && pred->next == tail) {
+          link(pred.get(), std::move(node), tail.get());
+          return;
+        }
+      }
+    }
+
+    //! Removes the first element in the linked list
+    //! \return false if the list was empty.
+    bool pop_front() {
+      NodePtr removed;
+      Lock head_lock(head->mtx);
+      Node* node = head->next.get();
+      if (node == tail.get()) {
+        return false;
+      }
+      Lock node_lock(node->mtx);
+      Node* succ = node->next.get();
+      Lock succ_lock(succ->mtx);
+      removed = unlink(head.get(), node, succ);
+      return true;
+    }
+
+    //! Removes the last element in the linked list.
+    //! \return false if the list was empty.
+    bool pop_back() {
+      for (;;) {
+        NodePtr node = prev_of(tail);
+        if (node == head) {
+          std::lock_guard head_lock(head->mtx);
+          if (head->next == tail) {
+            return false;
+          }
+          continue;
+        }
+        NodePtr pred = prev_of(node);
+        if (!pred) {
+          continue;// node was unlinked and its predecessor freed
+        }
+        Lock pred_lock(pred->mtx);
+        Lock node_lock(node->mtx);
+        Lock tail_lock(tail->mtx);
+        if (!pred->unlinked && pred->next == node && node->next == tail) {
+          // the local node pointer outlives the locks
+          static_cast<void>(unlink(pred.get(), node.get(), tail.get()));
+          return true;
+        }
+      }
+    }
+
+    //! \return a copy of the value at the front of the list, or none.
+    std::optional<T> front_val() const {
+      std::lock_guard head_lock(head->mtx);
+      return head->next->data;
+    }
+
+    //! \return a copy of the value at the back of the list, or none.
+    std::optional<T> back_val() const {
+      std::lock_guard tail_lock(tail->mtx);
+      return tail->prev.lock()->data;
+    }
+
+    //! Remove the first element with the given value.
+    //! \param match_val value to remove
+    //! \return false if the value wasn't found.
+    bool remove_first(const T& match_val) {
+      NodePtr removed;
+      return find_locked([&](const T& val) { return val == match_val; },
+                         [&](Node* pred, Node* node) {
+                           Node* succ = node->next.get();
+                           Lock succ_lock(succ->mtx);
+                           removed = unlink(pred, node, succ);
+                         });
+    }
+
+    //! Insert a new value in front of the first element with a given value.
+    //! \param match_val value to search for
+    //! \param new_val value to insert
+    //! \return false if the value wasn't found, nothing is inserted then.
+    bool insert_before(const T& match_val, const T& new_val) {
+      auto node = make_node(new_val);
+      return find_locked([&](const T& val) { return val == match_val; },
+                         [&](Node* pred, Node* succ) {
+                           link(pred, std::move(node), succ);
+                         });
+    }
+
+    //! Insert a new value after the first element with a given value.
+    //! \param match_val value to search for
+    //! \param new_val value to insert
+    //! \return false if the value wasn't found, nothing is inserted then.
+    bool insert_after(const T& match_val, const T& new_val) {
+      auto node = make_node(new_val);
+      return find_locked([&](const T& val) { return val == match_val; },
+                         [&](Node*, Node* match) {
+                           Node* succ = match->next.get();
+                           Lock succ_lock(succ->mtx);
+                           link(match, std::move(node), succ);
+                         });
+    }
+
+    //! \return whether the value is in the list
+    bool contains(const T& match_val) const {
+      return find_locked([&](const T& val) { return val == match_val; },
+                         [](Node*, Node*) {});
+    }
+
+    //! \return the number of elements at the time of the call
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    //! \return whether the list was empty at the time of the call
+    bool empty() const { return size() == 0; }
+
+    //! Weakly consistent forward iterator, it holds no lock between steps.
+    class ConstIterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type        = T;
+      using pointer           = const T*;
+      using reference         = const T&;
+
+      ConstIterator() = default;
+
+      reference operator*() const { return *node->data; }
+      pointer operator->() const { return &*node->data; }
+
+      ConstIterator& operator++() {
+        node = step(node);
+        return *this;
+      }
+      ConstIterator operator++(int) {
+        ConstIterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      friend bool operator==(const ConstIterator& a, const ConstIterator& b) {
+        return a.node == b.node;
+      }
+      friend bool operator!=(const ConstIterator& a, const ConstIterator& b) {
+        return a.node != b.node;
+      }
+
+    private:
+      friend class FineLockYall;
+      explicit ConstIterator(NodePtr node_) : node(std::move(node_)) {}
+
+      // the node after from, or null past the last element
+      static NodePtr step(const NodePtr& from) {
+        NodePtr next;
+        {
+          std::lock_guard lock(from->mtx);
+          next = from->next;
+        }
+        return next->data ? next : nullptr;
+      }
+
+      NodePtr node;
+    };
+
+    ConstIterator begin() const {
+      return ConstIterator(ConstIterator::step(head));
+    }
+    ConstIterator end() const { return ConstIterator(); }
+
+  private:
+    const NodePtr head = std::make_shared<Node>();
+    const NodePtr tail = std::make_shared<Node>();
+    std::atomic<size_t> count{0};
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_FINELOCK_HPP
@@ -0,0 +1,567 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_INDEXED_HPP
+#define YALL_INCLUDE_YALL_INDEXED_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace yall {
+
+  //! Doubly linked-list with a hash index on the values.
+  //!  Every mutation keeps a hash map from each distinct value to the chain
+  //!  of nodes holding it, so remove_first, remove_last, insert_before,
+  //!  insert_after and find are expected O(1) instead of a scan. The API and
+  //!  the duplicate semantics follow Yall: the "first" match is the one
+  //!  nearest the front, the "last" one is nearest the back.
+  //!
+  //!  The chain of equal values is kept in list order with the help of an
+  //!  order label per node. Linking a duplicate at either end of its chain is
+  //!  O(1), otherwise (insert_at, insert_before/after landing amid equal
+  //!  values) the chain is walked. Labels are spread out again when a gap
+  //!  runs out, which is amortised over the inserts that used the gap up.
+  //!
+  //!  Each node carries three extra words and each distinct value a map
+  //!  entry. Values can't be modified in place, so only const iterators are
+  //!  provided. Only value types can be stored.
+  //!
+  //!* \tparam T The type of the node data.
+  //!* \tparam Hash Hash function for T.
+  //!* \tparam KeyEqual Equality for T, used instead of operator==.
+  template<typename T, typename Hash = std::hash<T>,
+           typename KeyEqual = std::equal_to<T>>
+  class IndexedYall final {
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "IndexedYall stores values, use Yall for references");
+
+    struct Node {
+      template<class... Args>
+      explicit Node(std::in_place_t, Args&&... args)
+          : data(std::forward<Args>(args)...) {}
+
+      T data;
+      Node* prev = nullptr;
+      std::unique_ptr<Node> next;
+      // neighbours with an equal value, in list order
+      Node* dup_prev = nullptr;
+      Node* dup_next = nullptr;
+      std::uint64_t label = 0;
+    };
+    using NodePtr = std::unique_ptr<Node>;
+
+    // the nodes holding one value, the map key points at first->data
+    struct Chain {
+      Node* first;
+      Node* last;
+    };
+
+    struct DerefHash {
+      std::size_t operator()(const T* val) const { return hash(*val); }
+      [[no_unique_address]] Hash hash;
+    };
+    struct DerefEqual {
+      bool operator()(const T* a, const T* b) const { return equal(*a, *b); }
+      [[no_unique_address]] KeyEqual equal;
+    };
+    using Index = std::unordered_map<const T*, Chain, DerefHash, DerefEqual>;
+
+    static constexpr std::uint64_t max_label = std::numeric_limits<std::uint64_t>::max();
+    // label distance between nodes pushed at either end
+    static constexpr std::uint64_t label_step = std::uint64_t{1} << 32;
+
+    // relabel every node, evenly spread with room at both ends
+    void relabel_all() {
+      const std::uint64_t step = max_label / (count + 2);
+      std::uint64_t label      = 0;
+      for (auto* ptr = head.get(); ptr; ptr = ptr->next.get()) {
+        ptr->label = label += step;
+      }
+    }
+
+    // Spread out the nodes following pred until there is room after it. The
+    // window grows until it's sparse enough for its nodes to end up at
+    // least 2 (window size) apart, so the next relabel of it is far off.
+    void relabel_after(Node* pred) {
+      const std::uint64_t base = pred->label;
+      auto* end                = pred->next.get();
+      std::uint64_t k          = 0;
+      while (end && end->label - base <= 2 * (k + 1) * (k + 1)) {
+        end = end->next.get();
+        ++k;
+      }
+      const std::uint64_t span = (end ? end->label : max_label) - base;
+      const std::uint64_t step = span / (k + 1);
+      if (step < 2) {
+        relabel_all();
+        return;
+      }
+      auto* ptr = pred->next.get();
+      for (std::uint64_t i = 1; i <= k; ++i, ptr = ptr->next.get()) {
+        ptr->label = base + i * step;
+      }
+    }
+
+    // a label between the adjacent nodes pred and succ (null for the ends)
+    std::uint64_t label_between(Node* pred, Node* succ) {
+      if (!pred && !succ) {
+        return max_label / 2;
+      }
+      if (!succ) {
+        const auto room = max_label - pred->label;
+        if (room < 2) {
+          relabel_all();
+          return label_between(pred, succ);
+        }
+        return pred->label + std::min(label_step, room / 2);
+      }
+      if (!pred) {
+        if (succ->label < 2) {
+          relabel_all();
+          return label_between(pred, succ);
+        }
+        return succ->label - std::min(label_step, succ->label / 2);
+      }
+      if (succ->label - pred->label < 2) {
+        relabel_after(pred);
+      }
+      return pred->label + (succ->label - pred->label) / 2;
+    }
+
+    void rekey(typename Index::iterator it, Node* first) {
+      auto handle         = index.extract(it);
+      handle.key()        = &first->data;
+      handle.mapped().first = first;
+      index.insert(std::move(handle));
+    }
+
+    // add a node, labelled for its place in the list, to the chain of its
+    // value
+    void add_to_index(Node* node) {
+      auto [it, inserted] = index.try_emplace(&node->data, Chain{node, node});
+      if (inserted) {
+        return;
+      }
+      Chain& chain = it->second;
+      if (node->label > chain.last->label) {
+        node->dup_prev       = chain.last;
+        chain.last->dup_next = node;
+        chain.last           = node;
+      } else if (node->label < chain.first->label) {
+        node->dup_next        = chain.first;
+        chain.first->dup_prev = node;
+        rekey(it, node);
+      } else {
+        auto* pred = chain.last;
+        while (pred->label > node->label) {
+          pred = pred->dup_prev;
+        }
+        node->dup_prev           = pred;
+        node->dup_next           = pred->dup_next;
+        pred->dup_next->dup_prev = node;
+        pred->dup_next           = node;
+      }
+    }
+
+    void remove_from_index(Node* node) {
+      auto it      = index.find(&node->data);
+      Chain& chain = it->second;
+      if (chain.first == chain.last) {
+        index.erase(it);
+        return;
+      }
+      if (node->dup_prev) {
+        node->dup_prev->dup_next = node->dup_next;
+      }
+      if (node->dup_next) {
+        node->dup_next->dup_prev = node->dup_prev;
+      }
+      if (node == chain.last) {
+        chain.last = node->dup_prev;
+      }
+      if (node == chain.first) {
+        rekey(it, node->dup_next);
+      }
+    }
+
+    // link a new node in front of succ (at the back for null)
+    template<class... Args>
+    Node* link_before(Node* succ, Args&&... args) {
+      auto node     = std::make_unique<Node>(std::in_place,
+                                             std::forward<Args>(args)...);
+      auto* ptr     = node.get();
+      auto* pred    = succ ? succ->prev : tail;
+      ptr->label    = label_between(pred, succ);
+      // index it first, so a throwing insert leaves the list untouched
+      add_to_index(ptr);
+      NodePtr& slot = pred ? pred->next : head;
+      ptr->prev     = pred;
+      ptr->next     = std::move(slot);
+      if (succ) {
+        succ->prev = ptr;
+      } else {
+        tail = ptr;
+      }
+      slot = std::move(node);
+      ++count;
+      return ptr;
+    }
+
+    // unlink a node that is already out of the index and hand it over
+    NodePtr take(Node* node) {
+      NodePtr& slot = node->prev ? node->prev->next : head;
+      auto victim   = std::move(slot);
+      slot          = std::move(victim->next);
+      if (slot) {
+        slot->prev = victim->prev;
+      } else {
+        tail = victim->prev;
+      }
+      --count;
+      return victim;
+    }
+
+    // \return the node that followed it
+    Node* unlink(Node* node) {
+      auto* next = node->next.get();
+      remove_from_index(node);
+      take(node);
+      return next;
+    }
+
+    Node* first_of(const T& val) const {
+      auto it = index.find(&val);
+      return it == index.end() ? nullptr : it->second.first;
+    }
+
+    Node* last_of(const T& val) const {
+      auto it = index.find(&val);
+      return it == index.end() ? nullptr : it->second.last;
+    }
+
+  public:
+    IndexedYall() = default;
+    ~IndexedYall() { reset(); }
+
+    IndexedYall(const IndexedYall&)            = delete;
+    IndexedYall& operator=(const IndexedYall&) = delete;
+
+    IndexedYall(IndexedYall&& other) noexcept
+        : head(std::move(other.head)), tail(std::exchange(other.tail, nullptr)),
+          count(std::exchange(other.count, 0)), index(std::move(other.index)) {
+      other.index.clear();
+    }
+
+    IndexedYall& operator=(IndexedYall&& other) noexcept {
+      if (this != &other) {
+        reset();
+        head  = std::move(other.head);
+        tail  = std::exchange(other.tail, nullptr);
+        count = std::exchange(other.count, 0);
+        index = std::move(other.index);
+        other.index.clear();
+      }
+      return *this;
+    }
+
+    //! Insert a new node at the front of the list.
+    //! \param data node value
+    void push_front(const T& data) { emplace_front(data); }
+    void push_front(T&& data) { emplace_front(std::move(data)); }
+
+    //! Construct a new node value in place at the front of the list.
+    //! \return the new value
+    template<class... Args>
+    const T& emplace_front(Args&&... args) {
+      return link_before(head.get(), std::forward<Args>(args)...)->data;
+    }
+
+    //! Insert a new node at the back of the list.
+    //! \param data node value
+    void push_back(const T& data) { emplace_back(data); }
+    void push_back(T&& data) { emplace_back(std::move(data)); }
+
+    //! Construct a new node value in place at the back of the list.
+    //! \return the new value
+    template<class... Args>
+    const T& emplace_back(Args&&... args) {
+      return link_before(nullptr, std::forward<Args>(args)...)->data;
+    }
+
+    //! Removes the first element in the linked list
+    void pop_front() {
+      if (head) {
+        unlink(head.get());
+      }
+    }
+
+    //! Removes the last element in the linked list.
+    void pop_back() {
+      if (tail) {
+        unlink(tail);
+      }
+    }
+
+    //! Remove the first element, moving its value out.
+    //! \return the value that was at the front of the list, or none.
+    std::optional<T> pop_front_value() {
+      if (!head) {
+        return {};
+      }
+      remove_from_index(head.get());
+      return std::optional<T>(std::move(take(head.get())->data));
+    }
+
+    //! Remove the last element, moving its value out.
+    //! \return the value that was at the back of the list, or none.
+    std::optional<T> pop_back_value() {
+      if (!tail) {
+        return {};
+      }
+      remove_from_index(tail);
+      return std::optional<T>(std::move(take(tail)->data));
+    }
+
+    //! \return a copy of the value at the front of the list, or none.
+    std::optional<T> front_val() const {
+      if (head) {
+        return head->data;
+      }
+      return {};
+    }
+
+    //! \return a copy of the value at the back of the list, or none.
+    std::optional<T> back_val() const {
+      if (tail) {
+        return tail->data;
+      }
+      return {};
+    }
+
+    //! Get the value at the front of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool front(T& ref) const {
+      if (head) {
+        ref = head->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Get the value at the back of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool back(T& ref) const {
+      if (tail) {
+        ref = tail->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Remove the match nearest the front of the list, an index lookup.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_first(const T& match_val) {
+      if (auto* node = first_of(match_val)) {
+        unlink(node);
+        return true;
+      }
+      return false;
+    }
+
+    //! Remove the match nearest the back of the list, an index lookup.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_last(const T& match_val) {
+      if (auto* node = last_of(match_val)) {
+        unlink(node);
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value before that
+    //! @return true if the new value has been inserted into the list
+    bool insert_before(const T& match_val, const T& new_val) {
+      if (auto* node = first_of(match_val)) {
+        link_before(node, new_val);
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value after that
+    //! @return true if the new value has been inserted into the list
+    bool insert_after(const T& match_val, const T& new_val) {
+      if (auto* node = first_of(match_val)) {
+        link_before(node->next.get(), new_val);
+        return true;
+      }
+      return false;
+    }
+
+    //! Insert a new value so that it ends up at position indx, or at the back
+    //! of the list if indx is past the end. Finding the position is a walk.
+    void insert_at(size_t indx, const T& new_val) { emplace_at(indx, new_val); }
+
+    //! Construct a new value in place at position indx, or at the back of
+    //! the list if indx is past the end.
+    //! \return the new value
+    template<class... Args>
+    const T& emplace_at(size_t indx, Args&&... args) {
+      auto* ptr = head.get();
+      for (; ptr && indx > 0; --indx) {
+        ptr = ptr->next.get();
+      }
+      return link_before(ptr, std::forward<Args>(args)...)->data;
+    }
+
+    //! \return whether the value is in the list, an index lookup
+    bool contains(const T& match_val) const {
+      return first_of(match_val) != nullptr;
+    }
+
+    //! \return the number of elements equal to the value, found by walking
+    //!         the chain of equal values only
+    size_t count_of(const T& match_val) const {
+      size_t n = 0;
+      for (auto* ptr = first_of(match_val); ptr; ptr = ptr->dup_next) {
+        ++n;
+      }
+      return n;
+    }
+
+    using PrinterCB = std::function<void(const T&)>;
+
+    //! Print the values in the list, front-to-back.
+    //!
+    //! \param printer_cb callback that will print node data to stdout
+    void print(PrinterCB printer_cb) const {
+      for (auto* ptr = head.get(); ptr; ptr = ptr->next.get()) {
+        printer_cb(ptr->data);
+      }
+      std::cout << "|-\n";// list display "null-terminator"
+    }
+
+    //! Free all nodes (create an empty list), one node at a time.
+    void reset() noexcept {
+      index.clear();
+      while (head) {
+        head = std::move(head->next);
+      }
+      tail  = nullptr;
+      count = 0;
+    }
+
+    //! \return whether the list is empty
+    bool empty() const { return count == 0; }
+
+    //! \return the number of elements
+    size_t size() const { return count; }
+
+    //! \return the number of distinct values
+    size_t distinct() const { return index.size(); }
+
+    //! Bidirectional iterator over the values, stepping past either end
+    //! gives the end iterator (the same for both directions).
+    class ConstIterator {
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type        = T;
+      using pointer           = const T*;
+      using reference         = const T&;
+
+      ConstIterator() = default;
+
+      reference operator*() const { return node->data; }
+      pointer operator->() const { return &node->data; }
+
+      ConstIterator& operator++() {
+        node = node->next.get();
+        return *this;
+      }
+      ConstIterator operator++(int) {
+        ConstIterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+      ConstIterator& operator--() {
+        node = node->prev;
+        return *this;
+      }
+      ConstIterator operator--(int) {
+        ConstIterator tmp = *this;
+        --(*this);
+        return tmp;
+      }
+
+      friend bool operator==(const ConstIterator& a, const ConstIterator& b) {
+        return a.node == b.node;
+      }
+      friend bool operator!=(const ConstIterator& a, const ConstIterator& b) {
+        return a.node != b.node;
+      }
+
+    private:
+      friend class IndexedYall;
+      explicit ConstIterator(Node* node_) : node(node_) {}
+
+      Node* node = nullptr;
+    };
+
+    ConstIterator cbegin() const { return ConstIterator(head.get()); }
+    ConstIterator cend() const { return ConstIterator(); }
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+    ConstIterator crbegin() const { return ConstIterator(tail); }
+    ConstIterator crend() const { return ConstIterator(); }
+
+    //! \return an iterator to the first match, or end(), an index lookup
+    ConstIterator find(const T& match_val) const {
+      return ConstIterator(first_of(match_val));
+    }
+
+    //! \return an iterator to the last match, or end(), an index lookup
+    ConstIterator rfind(const T& match_val) const {
+      return ConstIterator(last_of(match_val));
+    }
+
+    //! Remove the element at pos.
+    //! \return an iterator to the element that followed it
+    ConstIterator erase(ConstIterator pos) {
+      return ConstIterator(unlink(pos.node));
+    }
+
+  private:
+    NodePtr head;
+    Node* tail   = nullptr;
+    size_t count = 0;
+    Index index;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_INDEXED_HPP
@@ -0,0 +1,112 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_IO_HPP
+#define YALL_INCLUDE_YALL_IO_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+
+//! The binary format of Yall::save and Yall::load.
+//!  A 24 byte header, then the values front to back:
+//!
+//!  | bytes | field                                          |
+//!  |-------|------------------------------------------------|
+//!  | 4     | magic "YALL"                                   |
+//!  | 1     | format version                                 |
+//!  | 1     | 1 if written on a little endian machine        |
+//!  | 1     | encoding, raw or codec                         |
+//!  | 1     | reserved, 0                                    |
+//!  | 4     | size of a value for raw, 0 for codec           |
+//!  | 4     | reserved, 0                                    |
+//!  | 8     | number of values                               |
+//!
+//!  Raw values are the bytes of trivially copyable values, in the byte
+//!  order of the machine that wrote them; a file from the other byte order
+//!  is refused. Codec values are whatever the codec writes.
+namespace yall::io {
+  inline constexpr std::uint8_t format_version = 1;
+
+  enum class Encoding : std::uint8_t { raw = 0, codec = 1 };
+
+  struct Header {
+    char magic[4]            = {'Y', 'A', 'L', 'L'};
+    std::uint8_t version     = format_version;
+    std::uint8_t little      = std::endian::native == std::endian::little;
+    Encoding encoding        = Encoding::raw;
+    std::uint8_t reserved    = 0;
+    std::uint32_t value_size = 0;
+    std::uint32_t reserved2  = 0;
+    std::uint64_t count      = 0;
+  };
+  static_assert(sizeof(Header) == 24 && std::is_trivially_copyable_v<Header>);
+
+  // raw values go through a buffer of this size, written and read in blocks
+  inline constexpr std::size_t block_bytes = std::size_t{1} << 14;
+
+  //! Writes and reads the values of a list that can't be copied as bytes.
+  //!  read returns none when the input is bad, the load then fails.
+  //!  \code
+  //!  struct FooCodec {
+  //!    void write(std::ostream& os, const Foo& foo);
+  //!    std::optional<Foo> read(std::istream& is);
+  //!  };
+  //!  \endcode
+  template<typename C, typename T>
+  concept Codec = requires(C& codec, std::ostream& os, std::istream& is,
+                           const T& val) {
+    codec.write(os, val);
+    { codec.read(is) } -> std::same_as<std::optional<T>>;
+  };
+
+  inline bool write_header(std::ostream& os, Encoding encoding,
+                           std::uint32_t value_size, std::uint64_t count) {
+    Header header;
+    header.encoding   = encoding;
+    header.value_size = value_size;
+    header.count      = count;
+    return static_cast<bool>(
+            os.write(reinterpret_cast<const char*>(&header), sizeof(header)));
+  }
+
+  //! Read a header and check it was written by this version, on a machine
+  //! with the same byte order, with the expected encoding and value size.
+  //! \return the number of values that follow, or none
+  inline std::optional<std::uint64_t>
+  read_header(std::istream& is, Encoding encoding, std::uint32_t value_size) {
+    Header header;
+    if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+      return {};
+    }
+    const Header expected;
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version ||
+        header.little != expected.little || header.encoding != encoding ||
+        header.value_size != value_size) {
+      return {};
+    }
+    return header.count;
+  }
+}// namespace yall::io
+
+#endif//YALL_INCLUDE_YALL_IO_HPP
@@ -0,0 +1,228 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_LRU_HPP
+#define YALL_INCLUDE_YALL_LRU_HPP
+
+#include "yall.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace yall {
+
+  //! Hits, misses and evictions of an LruCache.
+  struct LruStats {
+    //! get calls that found their key and those that didn't
+    std::uint64_t hits   = 0;
+    std::uint64_t misses = 0;
+    //! entries dropped from the back to make room for a new key
+    std::uint64_t evictions = 0;
+  };
+
+  //! Least recently used cache: a Yall of entries, most recent at the front,
+  //!  and a hash map from each key to its node.
+  //!  get, put, erase and touch are expected O(1). A hit relinks the entry's
+  //!  node to the front with Yall::move_to_front, nothing is allocated or
+  //!  moved. When the cache is full a new key takes over the node (and map
+  //!  entry) of the least recently used one, so a full cache doesn't
+  //!  allocate either.
+  //!
+  //!  Pointers to values returned by get and peek stay valid until the
+  //!  entry is erased or evicted.
+  //!
+  //!* \tparam K The type of the keys.
+  //!* \tparam V The type of the cached values.
+  //!* \tparam Hash Hash function for K.
+  //!* \tparam KeyEqual Equality for K.
+  template<typename K, typename V, typename Hash = std::hash<K>,
+           typename KeyEqual = std::equal_to<K>>
+  class LruCache final {
+    static_assert(std::is_object_v<K> && std::is_object_v<V>,
+                  "LruCache stores keys and values, not references");
+
+  public:
+    //! A cached key and its value.
+    struct Entry {
+      K key;
+      V value;
+    };
+
+  private:
+    using List  = Yall<Entry, std::allocator<Entry>, UniqueOwnership>;
+    using Index = std::unordered_map<K, typename List::Iterator, Hash,
+                                     KeyEqual>;
+
+    // move the entry to the front of the list, a relink
+    void to_front(typename List::Iterator it) {
+      entries.move_to_front(it);
+    }
+
+    // drop the least recently used entry
+    void evict() {
+      index.erase(entries.back_ref().key);
+      entries.pop_back();
+      ++counters.evictions;
+    }
+
+  public:
+    //! \param capacity_ the most entries the cache holds, 0 caches nothing
+    explicit LruCache(std::size_t capacity_) : max_size(capacity_) {}
+
+    LruCache(const LruCache&)            = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    LruCache(LruCache&&) noexcept            = default;
+    LruCache& operator=(LruCache&&) noexcept = default;
+
+    //! Look a key up and make it the most recently used, a hit or a miss
+    //! is recorded.
+    //! \return the cached value, or null on a miss
+    V* get(const K& key) {
+      auto found = index.find(key);
+      if (found == index.end()) {
+        ++counters.misses;
+        return nullptr;
+      }
+      ++counters.hits;
+      to_front(found->second);
+      return &found->second->value;
+    }
+
+    //! Look a key up without changing the order or the stats.
+    //! \return the cached value, or null
+    const V* peek(const K& key) const {
+      auto found = index.find(key);
+      return found == index.end() ? nullptr : &found->second->value;
+    }
+
+    //! Store a value for the key and make it the most recently used. A full
+    //! cache evicts its least recently used entry and reuses its node.
+    //! \return true if the key is new, false if its value was replaced (or
+    //!         the capacity is 0)
+    bool put(K key, V value) {
+      if (auto found = index.find(key); found != index.end()) {
+        found->second->value = std::move(value);
+        to_front(found->second);
+        return false;
+      }
+      if (max_size == 0) {
+        return false;
+      }
+      if (entries.size() < max_size) {
+        entries.emplace_front(Entry{key, std::move(value)});
+        try {
+          index.emplace(std::move(key), entries.begin());
+        } catch (...) {
+          entries.pop_front();
+          throw;
+        }
+        return true;
+      }
+      // take over the least recently used node and its map entry
+      auto handle = index.extract(entries.back_ref().key);
+      auto last   = handle.mapped();
+      // the old entry is gone whether or not the new one makes it in
+      ++counters.evictions;
+      try {
+        last->key    = key;
+        last->value  = std::move(value);
+        handle.key() = std::move(key);
+      } catch (...) {
+        entries.pop_back();
+        throw;
+      }
+      to_front(last);
+      index.insert(std::move(handle));
+      return true;
+    }
+
+    //! Remove the key's entry.
+    //! \return true if the key was cached
+    bool erase(const K& key) {
+      auto found = index.find(key);
+      if (found == index.end()) {
+        return false;
+      }
+      entries.erase(found->second);
+      index.erase(found);
+      return true;
+    }
+
+    //! Make the key the most recently used without looking at its value,
+    //! the stats are left alone.
+    //! \return true if the key is cached
+    bool touch(const K& key) {
+      auto found = index.find(key);
+      if (found == index.end()) {
+        return false;
+      }
+      to_front(found->second);
+      return true;
+    }
+
+    //! \return whether the key is cached, the order is left alone
+    bool contains(const K& key) const { return index.contains(key); }
+
+    //! Change the capacity, evicting the least recently used entries that
+    //! no longer fit.
+    void set_capacity(std::size_t capacity_) {
+      max_size = capacity_;
+      while (entries.size() > max_size) {
+        evict();
+      }
+    }
+
+    //! Drop every entry, the stats are kept.
+    void clear() {
+      index.clear();
+      entries.reset();
+    }
+
+    //! \return the number of cached entries
+    std::size_t size() const { return entries.size(); }
+
+    //! \return whether nothing is cached
+    bool empty() const { return entries.empty(); }
+
+    //! \return the most entries the cache holds
+    std::size_t capacity() const { return max_size; }
+
+    //! \return the hits, misses and evictions so far
+    const LruStats& stats() const { return counters; }
+
+    //! Zero the hits, misses and evictions.
+    void clear_stats() { counters = LruStats{}; }
+
+    using ConstIterator = typename List::ConstIterator;
+
+    //! Iteration over the entries, most recently used first.
+    ConstIterator begin() const { return entries.cbegin(); }
+    ConstIterator end() const { return entries.cend(); }
+
+  private:
+    List entries;
+    Index index;
+    std::size_t max_size;
+    LruStats counters;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_LRU_HPP
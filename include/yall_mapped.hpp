@@ -0,0 +1,585 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_MAPPED_HPP
+#define YALL_INCLUDE_YALL_MAPPED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yall {
+
+  //! Doubly linked-list kept in a memory-mapped file (POSIX only).
+  //!  The nodes, the list head, tail and size all live in the file and the
+  //!  links are file offsets, so a list is usable as soon as its file is
+  //!  mapped: open() checks the header and does no per-node work. Every
+  //!  mutation goes straight to the mapping; flush() starts writing dirty
+  //!  pages back and sync() waits until they are on disk. Without either
+  //!  the kernel writes them back in its own time, which survives the
+  //!  process but not a crash of the machine. A mutation interrupted by a
+  //!  crash can leave the file inconsistent.
+  //!
+  //!  Removed nodes go on a free list kept in the file. The file grows (by
+  //!  doubling) when there are no free nodes left, which remaps it, so
+  //!  references to values are invalidated by growth. Iterators hold
+  //!  offsets and stay valid. Values are stored as bytes, so T must be
+  //!  trivially copyable, and the file can only be read on a machine with
+  //!  the same layout for T.
+  //!
+  //!  The list has to be open to add to it: push_*, emplace_*, insert_at
+  //!  and insert throw std::logic_error otherwise. Everything else treats
+  //!  a closed list as an empty one.
+  //!
+  //!* \tparam T The type of the node data.
+  template<typename T>
+  class MappedYall final {
+    static_assert(std::is_trivially_copyable_v<T> && !std::is_const_v<T>,
+                  "MappedYall stores values as bytes");
+
+    using Offset = std::uint64_t;
+
+    struct Node {
+      Offset prev;
+      Offset next;// the next free node while on the free list
+      T data;
+    };
+
+    struct Header {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t value_size;
+      std::uint64_t node_size;
+      std::uint64_t count;
+      Offset head;
+      Offset tail;
+      Offset free_head;
+      // end of the part of the file handed out to nodes so far
+      Offset used;
+    };
+    static_assert(sizeof(Header) == 64);
+
+    static constexpr char magic[8]            = "YALLMAP";
+    static constexpr std::uint32_t version    = 1;
+    static constexpr std::size_t initial_size = std::size_t{1} << 16;
+    // offset of the first node, past the header
+    static constexpr Offset first_node =
+            (sizeof(Header) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    Header* header() const { return reinterpret_cast<Header*>(base); }
+
+    Node* node(Offset off) const {
+      return off ? std::launder(reinterpret_cast<Node*>(base + off)) : nullptr;
+    }
+
+    // map the whole file, size bytes
+    bool map(std::size_t size) {
+      void* addr =
+              ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (addr == MAP_FAILED) {
+        return false;
+      }
+      base        = static_cast<std::byte*>(addr);
+      mapped_size = size;
+      return true;
+    }
+
+    // remap the file with at least needed bytes, doubling its size until it
+    // fits; the old mapping stays until the new one is in place
+    void grow(std::size_t needed) {
+      auto new_size = mapped_size;
+      while (new_size < needed) {
+        new_size *= 2;
+      }
+      if (::ftruncate(fd, static_cast<off_t>(new_size)) != 0) {
+        throw std::bad_alloc();
+      }
+      auto* old_base      = base;
+      const auto old_size = mapped_size;
+      if (!map(new_size)) {
+        throw std::bad_alloc();
+      }
+      ::munmap(old_base, old_size);
+    }
+
+    // \return a node from the free list or from the unused end of the file
+    template<class... Args>
+    Offset make_node(Args&&... args) {
+      auto* hdr  = header();
+      Offset off = hdr->free_head;
+      if (off) {
+        hdr->free_head = node(off)->next;
+      } else if (hdr->used + sizeof(Node) > mapped_size) {
+        // the arguments may refer into the mapping that grow() replaces,
+        // so the value is made before it
+        const T val = T(std::forward<Args>(args)...);
+        grow(hdr->used + sizeof(Node));
+        hdr = header();
+        off = hdr->used;
+        hdr->used += sizeof(Node);
+        auto* ptr = node(off);
+        ptr->prev = ptr->next = 0;
+        std::construct_at(&ptr->data, val);
+        return off;
+      } else {
+        off = hdr->used;
+        hdr->used += sizeof(Node);
+      }
+      auto* ptr = node(off);
+      ptr->prev = ptr->next = 0;
+      std::construct_at(&ptr->data, std::forward<Args>(args)...);
+      return off;
+    }
+
+    // link a new node in front of succ (at the back for 0)
+    template<class... Args>
+    Offset link_before(Offset succ, Args&&... args) {
+      if (!base) {
+        throw std::logic_error("yall::MappedYall: no file is open");
+      }
+      const Offset off = make_node(std::forward<Args>(args)...);
+      auto* hdr        = header();
+      auto* ptr        = node(off);
+      const Offset pred = succ ? node(succ)->prev : hdr->tail;
+      ptr->prev         = pred;
+      ptr->next         = succ;
+      (pred ? node(pred)->next : hdr->head) = off;
+      (succ ? node(succ)->prev : hdr->tail) = off;
+      ++hdr->count;
+      return off;
+    }
+
+    // unlink the node and put it on the free list
+    // \return the node that followed it
+    Offset unlink(Offset off) {
+      auto* hdr = header();
+      auto* ptr = node(off);
+      const Offset next = ptr->next;
+      (ptr->prev ? node(ptr->prev)->next : hdr->head) = next;
+      (next ? node(next)->prev : hdr->tail)           = ptr->prev;
+      ptr->next      = hdr->free_head;
+      hdr->free_head = off;
+      --hdr->count;
+      return next;
+    }
+
+    Offset find_offset(const T& match_val) const {
+      for (Offset off = head_off(); off; off = node(off)->next) {
+        if (node(off)->data == match_val) {
+          return off;
+        }
+      }
+      return 0;
+    }
+
+    Offset head_off() const { return base ? header()->head : 0; }
+    Offset tail_off() const { return base ? header()->tail : 0; }
+
+  public:
+    MappedYall() = default;
+    ~MappedYall() { close(); }
+
+    MappedYall(const MappedYall&)            = delete;
+    MappedYall& operator=(const MappedYall&) = delete;
+
+    MappedYall(MappedYall&& other) noexcept
+        : fd(std::exchange(other.fd, -1)),
+          base(std::exchange(other.base, nullptr)),
+          mapped_size(std::exchange(other.mapped_size, 0)) {}
+
+    MappedYall& operator=(MappedYall&& other) noexcept {
+      if (this != &other) {
+        close();
+        fd          = std::exchange(other.fd, -1);
+        base        = std::exchange(other.base, nullptr);
+        mapped_size = std::exchange(other.mapped_size, 0);
+      }
+      return *this;
+    }
+
+    //! Open the list stored in a file, or start an empty one if the file
+    //! doesn't exist or is empty. Only the header is checked.
+    //! \return false if the file can't be opened or mapped, or holds
+    //!         something other than a list of this value type
+    bool open(const std::string& path) {
+      close();
+      fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+      if (fd < 0) {
+        return false;
+      }
+      struct stat st {};
+      if (::fstat(fd, &st) != 0) {
+        close();
+        return false;
+      }
+      auto size = static_cast<std::size_t>(st.st_size);
+      if (size == 0) {
+        if (::ftruncate(fd, static_cast<off_t>(initial_size)) != 0 ||
+            !map(initial_size)) {
+          close();
+          return false;
+        }
+        auto* hdr = header();
+        std::memcpy(hdr->magic, magic, sizeof(magic));
+        hdr->version    = version;
+        hdr->value_size = sizeof(T);
+        hdr->node_size  = sizeof(Node);
+        hdr->used       = first_node;
+        return true;
+      }
+      if (size < sizeof(Header) || !map(size)) {
+        close();
+        return false;
+      }
+      const auto* hdr = header();
+      if (std::memcmp(hdr->magic, magic, sizeof(magic)) != 0 ||
+          hdr->version != version || hdr->value_size != sizeof(T) ||
+          hdr->node_size != sizeof(Node) || hdr->used > size) {
+        close();
+        return false;
+      }
+      return true;
+    }
+
+    //! \return whether a file is open
+    bool is_open() const { return base != nullptr; }
+
+    //! Unmap and close the file. Nothing is lost, the kernel still writes
+    //! back whatever hasn't been synced.
+    void close() noexcept {
+      if (base) {
+        ::munmap(base, mapped_size);
+        base        = nullptr;
+        mapped_size = 0;
+      }
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+
+    //! Start writing the changed pages back to the file, without waiting.
+    //! \return false if the write back couldn't be scheduled
+    bool flush() { return base && ::msync(base, mapped_size, MS_ASYNC) == 0; }
+
+    //! Write the changed pages back and wait until they are on disk.
+    //! \return false if the write back failed
+    bool sync() {
+      return base && ::msync(base, mapped_size, MS_SYNC) == 0 &&
+             ::fsync(fd) == 0;
+    }
+
+    //! Insert a new node at the front of the list.
+    //! \param data node value
+    //! \throw std::logic_error if no file is open
+    void push_front(const T& data) { emplace_front(data); }
+
+    //! Construct a new node value in place at the front of the list.
+    //! \return the new value
+    //! \throw std::logic_error if no file is open
+    template<class... Args>
+    T& emplace_front(Args&&... args) {
+      return node(link_before(head_off(), std::forward<Args>(args)...))->data;
+    }
+
+    //! Insert a new node at the back of the list.
+    //! \param data node value
+    //! \throw std::logic_error if no file is open
+    void push_back(const T& data) { emplace_back(data); }
+
+    //! Construct a new node value in place at the back of the list.
+    //! \return the new value
+    //! \throw std::logic_error if no file is open
+    template<class... Args>
+    T& emplace_back(Args&&... args) {
+      return node(link_before(0, std::forward<Args>(args)...))->data;
+    }
+
+    //! Removes the first element in the linked list
+    void pop_front() {
+      if (auto off = head_off()) {
+        unlink(off);
+      }
+    }
+
+    //! Removes the last element in the linked list.
+    void pop_back() {
+      if (auto off = tail_off()) {
+        unlink(off);
+      }
+    }
+
+    //! Remove the first element, copying its value out.
+    //! \return the value that was at the front of the list, or none.
+    std::optional<T> pop_front_value() {
+      auto val = front_val();
+      pop_front();
+      return val;
+    }
+
+    //! Remove the last element, copying its value out.
+    //! \return the value that was at the back of the list, or none.
+    std::optional<T> pop_back_value() {
+      auto val = back_val();
+      pop_back();
+      return val;
+    }
+
+    //! \return a copy of the value at the front of the list, or none.
+    std::optional<T> front_val() const {
+      if (auto off = head_off()) {
+        return node(off)->data;
+      }
+      return {};
+    }
+
+    //! \return a copy of the value at the back of the list, or none.
+    std::optional<T> back_val() const {
+      if (auto off = tail_off()) {
+        return node(off)->data;
+      }
+      return {};
+    }
+
+    //! Get the value at the front of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool front(T& ref) const {
+      if (auto off = head_off()) {
+        ref = node(off)->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Get the value at the back of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool back(T& ref) const {
+      if (auto off = tail_off()) {
+        ref = node(off)->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Start from the front of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_first(const T& match_val) {
+      if (auto off = find_offset(match_val)) {
+        unlink(off);
+        return true;
+      }
+      return false;
+    }
+
+    //! Start from the back of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_last(const T& match_val) {
+      for (Offset off = tail_off(); off; off = node(off)->prev) {
+        if (node(off)->data == match_val) {
+          unlink(off);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value before that
+    //! @return true if the new value has been inserted into the list
+    bool insert_before(const T& match_val, const T& new_val) {
+      if (auto off = find_offset(match_val)) {
+        link_before(off, new_val);
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value after that
+    //! @return true if the new value has been inserted into the list
+    bool insert_after(const T& match_val, const T& new_val) {
+      if (auto off = find_offset(match_val)) {
+        link_before(node(off)->next, new_val);
+        return true;
+      }
+      return false;
+    }
+
+    //! Insert a new value so that it ends up at position indx, or at the back
+    //! of the list if indx is past the end.
+    //! \throw std::logic_error if no file is open
+    void insert_at(std::size_t indx, const T& new_val) {
+      emplace_at(indx, new_val);
+    }
+
+    //! Construct a new value in place at position indx, or at the back of
+    //! the list if indx is past the end.
+    //! \return the new value
+    //! \throw std::logic_error if no file is open
+    template<class... Args>
+    T& emplace_at(std::size_t indx, Args&&... args) {
+      Offset off = head_off();
+      for (; off && indx > 0; --indx) {
+        off = node(off)->next;
+      }
+      return node(link_before(off, std::forward<Args>(args)...))->data;
+    }
+
+    using PrinterCB = std::function<void(const T&)>;
+
+    //! Print the values in the list, front-to-back.
+    //!
+    //! \param printer_cb callback that will print node data to stdout
+    void print(PrinterCB printer_cb) const {
+      for (Offset off = head_off(); off; off = node(off)->next) {
+        printer_cb(node(off)->data);
+      }
+      std::cout << "|-\n";// list display "null-terminator"
+    }
+
+    //! Empty the list, in O(1): the whole node area is up for reuse, the
+    //! file keeps its size.
+    void reset() noexcept {
+      if (auto* hdr = base ? header() : nullptr) {
+        hdr->count     = 0;
+        hdr->head      = 0;
+        hdr->tail      = 0;
+        hdr->free_head = 0;
+        hdr->used      = first_node;
+      }
+    }
+
+    //! \return whether the list is empty
+    bool empty() const { return size() == 0; }
+
+    //! \return the number of elements, stored in the file
+    std::size_t size() const { return base ? header()->count : 0; }
+
+    //! Bidirectional iterator, stepping past either end gives the end
+    //! iterator (the same for both directions). It holds a node offset, so
+    //! it survives the file growing.
+    template<bool IsConst>
+    struct BasicIterator {
+      // iterator traits
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type        = T;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      explicit BasicIterator() = default;
+
+      template<bool OtherConst>
+        requires(IsConst && !OtherConst)
+      BasicIterator(const BasicIterator<OtherConst>& other)
+          : list(other.list), off(other.off) {}
+
+      reference operator*() const { return list->node(off)->data; }
+      pointer operator->() const { return &list->node(off)->data; }
+
+      BasicIterator& operator++() {
+        off = list->node(off)->next;
+        return *this;
+      }
+
+      BasicIterator operator++(int) {
+        BasicIterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      BasicIterator& operator--() {
+        off = list->node(off)->prev;
+        return *this;
+      }
+
+      BasicIterator operator--(int) {
+        BasicIterator tmp = *this;
+        --(*this);
+        return tmp;
+      }
+
+      friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+        return a.off == b.off;
+      };
+      friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+        return a.off != b.off;
+      };
+
+    private:
+      friend class MappedYall;
+      friend struct BasicIterator<!IsConst>;
+
+      BasicIterator(const MappedYall* list_, Offset off_)
+          : list(list_), off(off_) {}
+
+      const MappedYall* list = nullptr;
+      Offset off             = 0;
+    };
+
+    using Iterator      = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    ConstIterator cbegin() const { return ConstIterator(this, head_off()); }
+    ConstIterator cend() const { return ConstIterator(this, 0); }
+    Iterator begin() { return Iterator(this, head_off()); }
+    Iterator end() { return Iterator(this, 0); }
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+    ConstIterator crbegin() const { return ConstIterator(this, tail_off()); }
+    ConstIterator crend() const { return ConstIterator(this, 0); }
+
+    //! Start from the front of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator find(const T& match_val) {
+      return Iterator(this, find_offset(match_val));
+    }
+
+    //! Insert a new value in front of pos (at the back for the end iterator).
+    //! \return an iterator to the new value
+    //! \throw std::logic_error if no file is open
+    Iterator insert(ConstIterator pos, const T& new_val) {
+      return Iterator(this, link_before(pos.off, new_val));
+    }
+
+    //! Remove the value at pos, which must be dereferenceable.
+    //! \return an iterator to the value that followed the removed one
+    Iterator erase(ConstIterator pos) { return Iterator(this, unlink(pos.off)); }
+
+  private:
+    int fd                  = -1;
+    std::byte* base         = nullptr;
+    std::size_t mapped_size = 0;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_MAPPED_HPP
@@ -0,0 +1,332 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_PARALLEL_HPP
+#define YALL_INCLUDE_YALL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//! Parallel algorithms over the lists of this library (Yall, UnrolledYall,
+//! IndexedYall or anything with begin/end/size).
+//!  A linked list can't be split by index, so the list is cut into
+//!  contiguous segments in one pass and the segments are shared out between
+//!  the calling thread and a pool of worker threads. The workers are started
+//!  the first time they're needed and kept for the whole program. The split
+//!  is a plain walk, it pays off when the per-element work is worth more
+//!  than a pointer hop, or when the same Segments are used for several
+//!  passes. The list must not be modified while an algorithm runs,
+//!  and Segments are invalidated by any insert or erase, like iterators.
+namespace yall {
+  namespace detail {
+    // a list that can be walked and divided, the overloads taking a list
+    // need it so as not to pick up a non-const Segments
+    template<typename List>
+    concept Walkable = requires(List& list) {
+      list.begin();
+      list.end();
+      list.size();
+    };
+
+    // segments shorter than this aren't worth a thread
+    constexpr std::size_t min_segment = 1 << 12;
+
+    inline unsigned default_threads() {
+      const unsigned n = std::thread::hardware_concurrency();
+      return n ? n : 1;
+    }
+
+    // Threads kept for the whole program, so the algorithms don't start
+    // threads on every call. The pool grows to the most threads any call
+    // has asked for (less the caller's own). One caller at a time gets the
+    // workers, a second caller (or a task calling an algorithm itself) runs
+    // its tasks on its own thread.
+    class WorkerPool {
+      // a batch of tasks, workers and the caller take the next one until
+      // there are none left
+      struct Job {
+        void* task;
+        void (*call)(void*, std::size_t);
+        std::size_t n;
+        std::atomic<std::size_t> next{0};
+      };
+
+    public:
+      static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+      }
+
+      ~WorkerPool() {
+        stopping = true;
+        ++generation;
+        generation.notify_all();
+      }
+
+      // run task(0) .. task(n - 1), task mustn't throw
+      // \return false, having run nothing, if another caller has the
+      //         workers
+      template<typename Task>
+      bool run(std::size_t n, Task& task) {
+        if (busy.exchange(true, std::memory_order_acquire)) {
+          return false;
+        }
+        try {
+          while (workers.size() + 1 < n) {
+            workers.emplace_back([this] { serve(); });
+          }
+        } catch (...) {
+          // no more threads to be had, those there are share the tasks
+        }
+        Job job{&task,
+                [](void* t, std::size_t i) { (*static_cast<Task*>(t))(i); },
+                n};
+        current = &job;
+        ++generation;
+        generation.notify_all();
+        work(job);
+        // the job lives on this stack, wait for every worker to leave it; a
+        // worker arriving from now on finds no job
+        current = nullptr;
+        for (auto h = helping.load(); h != 0; h = helping.load()) {
+          helping.wait(h);
+        }
+        busy.store(false, std::memory_order_release);
+        return true;
+      }
+
+    private:
+      WorkerPool() = default;
+
+      static void work(Job& job) {
+        for (auto i = job.next++; i < job.n; i = job.next++) {
+          job.call(job.task, i);
+        }
+      }
+
+      void serve() {
+        std::uint64_t seen = 0;
+        while (true) {
+          generation.wait(seen);
+          seen = generation.load();
+          if (stopping) {
+            return;
+          }
+          ++helping;
+          if (auto* job = current.load()) {
+            work(*job);
+          }
+          if (--helping == 0) {
+            helping.notify_one();
+          }
+        }
+      }
+
+      std::atomic<bool> busy{false};
+      std::atomic<bool> stopping{false};
+      // bumped for every job, the workers sleep on it
+      std::atomic<std::uint64_t> generation{0};
+      std::atomic<Job*> current{nullptr};
+      // workers looking at current
+      std::atomic<unsigned> helping{0};
+      // last, so the threads are joined before the rest goes
+      std::vector<std::jthread> workers;
+    };
+
+    // run task(0) .. task(n - 1) on the worker pool and the calling thread,
+    // the first exception thrown by a task is rethrown
+    template<typename Task>
+    void run_parallel(std::size_t n, Task&& task) {
+      std::vector<std::exception_ptr> errors(n);
+      auto guarded = [&](std::size_t i) {
+        try {
+          task(i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      };
+      if (n < 2 || !WorkerPool::instance().run(n, guarded)) {
+        for (std::size_t i = 0; i < n; ++i) {
+          guarded(i);
+        }
+      }
+      for (auto& error: errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+  }// namespace detail
+
+  //! Boundaries dividing a list into contiguous segments of about the same
+  //! length, found in one walk over the list.
+  template<detail::Walkable List>
+  class Segments {
+  public:
+    using Iter = decltype(std::declval<List&>().begin());
+
+    //! \param list the list to divide
+    //! \param parts the number of segments wanted, fewer are made for short
+    //!        lists so that a segment is never tiny
+    Segments(List& list, unsigned parts = detail::default_threads()) {
+      const std::size_t len = list.size();
+      std::size_t n =
+              std::min<std::size_t>(parts, len / detail::min_segment);
+      n = std::max<std::size_t>(n, 1);
+
+      bounds.reserve(n + 1);
+      auto it = list.begin();
+      bounds.push_back(it);
+      for (std::size_t i = 1; i < n; ++i) {
+        // segment i - 1 gets its share of len, the first ones the remainder
+        auto step = len / n + (i - 1 < len % n ? 1 : 0);
+        while (step--) {
+          ++it;
+        }
+        bounds.push_back(it);
+      }
+      bounds.push_back(list.end());
+    }
+
+    //! \return the number of segments
+    std::size_t size() const { return bounds.size() - 1; }
+
+    Iter begin(std::size_t i) const { return bounds[i]; }
+    Iter end(std::size_t i) const { return bounds[i + 1]; }
+
+  private:
+    std::vector<Iter> bounds;
+  };
+
+  //! Call f for every element, segments run concurrently, so f must be safe
+  //! to call from several threads at once.
+  template<typename List, typename F>
+  void par_for_each(const Segments<List>& segs, F f) {
+    detail::run_parallel(segs.size(), [&](std::size_t i) {
+      for (auto it = segs.begin(i); it != segs.end(i); ++it) {
+        f(*it);
+      }
+    });
+  }
+
+  template<detail::Walkable List, typename F>
+  void par_for_each(List& list, F f,
+                    unsigned threads = detail::default_threads()) {
+    par_for_each(Segments<List>(list, threads), std::move(f));
+  }
+
+  //! Fold the (projected) elements with op, which must be associative but
+  //! needn't be commutative: the segments are folded separately and the
+  //! partial results are combined in list order, starting with init.
+  //! \return init for an empty list
+  template<typename List, typename T, typename Op,
+           typename Proj = std::identity>
+  T par_reduce(const Segments<List>& segs, T init, Op op, Proj proj = {}) {
+    std::vector<std::optional<T>> partial(segs.size());
+    detail::run_parallel(segs.size(), [&](std::size_t i) {
+      auto it = segs.begin(i);
+      if (it == segs.end(i)) {
+        return;
+      }
+      T acc(std::invoke(proj, *it));
+      for (++it; it != segs.end(i); ++it) {
+        acc = op(std::move(acc), std::invoke(proj, *it));
+      }
+      partial[i] = std::move(acc);
+    });
+    for (auto& part: partial) {
+      if (part) {
+        init = op(std::move(init), std::move(*part));
+      }
+    }
+    return init;
+  }
+
+  template<detail::Walkable List, typename T, typename Op,
+           typename Proj = std::identity>
+  T par_reduce(List& list, T init, Op op, Proj proj = {},
+               unsigned threads = detail::default_threads()) {
+    return par_reduce(Segments<List>(list, threads), std::move(init),
+                      std::move(op), std::move(proj));
+  }
+
+  //! Find the first element, nearest the front, for which pred holds.
+  //! Segments behind one that already has a match give up early.
+  //! \return an iterator to the match or the end iterator
+  template<typename List, typename Pred>
+  auto par_find_if(const Segments<List>& segs, Pred pred) {
+    constexpr std::size_t none = static_cast<std::size_t>(-1);
+    std::atomic<std::size_t> first_hit{none};
+    std::vector<typename Segments<List>::Iter> hits(segs.size());
+    detail::run_parallel(segs.size(), [&](std::size_t i) {
+      for (auto it = segs.begin(i); it != segs.end(i); ++it) {
+        if (first_hit.load(std::memory_order_relaxed) < i) {
+          return;
+        }
+        if (pred(*it)) {
+          hits[i]       = it;
+          auto expected = first_hit.load(std::memory_order_relaxed);
+          while (i < expected &&
+                 !first_hit.compare_exchange_weak(expected, i)) {
+          }
+          return;
+        }
+      }
+    });
+    const auto hit = first_hit.load();
+    return hit == none ? segs.end(segs.size() - 1) : hits[hit];
+  }
+
+  template<detail::Walkable List, typename Pred>
+  auto par_find_if(List& list, Pred pred,
+                   unsigned threads = detail::default_threads()) {
+    return par_find_if(Segments<List>(list, threads), std::move(pred));
+  }
+
+  //! \return the number of elements for which pred holds
+  template<typename List, typename Pred>
+  std::size_t par_count_if(const Segments<List>& segs, Pred pred) {
+    std::vector<std::size_t> counts(segs.size());
+    detail::run_parallel(segs.size(), [&](std::size_t i) {
+      std::size_t n = 0;
+      for (auto it = segs.begin(i); it != segs.end(i); ++it) {
+        n += pred(*it) ? 1 : 0;
+      }
+      counts[i] = n;
+    });
+    std::size_t total = 0;
+    for (auto n: counts) {
+      total += n;
+    }
+    return total;
+  }
+
+  template<detail::Walkable List, typename Pred>
+  std::size_t par_count_if(List& list, Pred pred,
+                           unsigned threads = detail::default_threads()) {
+    return par_count_if(Segments<List>(list, threads), std::move(pred));
+  }
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_PARALLEL_HPP
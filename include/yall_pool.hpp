@@ -0,0 +1,296 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_POOL_HPP
+#define YALL_INCLUDE_YALL_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+
+namespace yall {
+  namespace detail {
+    constexpr std::size_t align_up(std::size_t n) {
+      constexpr std::size_t a = alignof(std::max_align_t);
+      return (n + a - 1) & ~(a - 1);
+    }
+  }// namespace detail
+
+  //! Slab allocator for list nodes.
+  //!  Blocks are carved out of chunks obtained from the upstream resource and
+  //!  freed blocks go onto a per-size free list, so a list that keeps pushing
+  //!  and popping reuses the same memory without touching the heap.
+  //!  recycle_all() hands back every block in one go, keeping the chunks.
+  //!  Each distinct (rounded up) block size gets its own free list; requests
+  //!  that are too big or over-aligned are passed to the upstream resource.
+  //!
+  //!  The pool is not thread safe, share it only between lists that are used
+  //!  from the same thread.
+  class NodePool final : public std::pmr::memory_resource {
+  public:
+    static constexpr std::size_t max_block_size   = 512;
+    static constexpr std::size_t max_size_classes = 8;
+
+    //! \param blocks_per_chunk number of blocks in the first chunk of each
+    //!        block size, later chunks double in size up to 64x this value
+    //! \param upstream_ where the chunks come from
+    explicit NodePool(std::size_t blocks_per_chunk = 64,
+                      std::pmr::memory_resource* upstream_ =
+                              std::pmr::get_default_resource())
+        : first_chunk_blocks(blocks_per_chunk ? blocks_per_chunk : 1),
+          upstream(upstream_) {}
+
+    ~NodePool() override { release(); }
+
+    NodePool(const NodePool&)            = delete;
+    NodePool(NodePool&&)                 = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool& operator=(NodePool&&)      = delete;
+
+    //! Give every chunk back to the upstream resource, whether or not the
+    //! blocks in it are still in use.
+    void release() noexcept {
+      for (std::size_t i = 0; i < n_classes; ++i) {
+        auto& cls = classes[i];
+        free_chunks(cls.chunks);
+        free_chunks(cls.spare);
+        cls = SizeClass{cls.block_size, first_chunk_blocks};
+      }
+      live = 0;
+    }
+
+    //! Mark every block as free without giving the chunks back, which is
+    //! O(number of chunks) rather than O(number of blocks).
+    //! Only valid when none of the blocks is still in use (or the owner of the
+    //! blocks will never touch them again and doesn't need them destroyed).
+    void recycle_all() noexcept {
+      for (std::size_t i = 0; i < n_classes; ++i) {
+        auto& cls = classes[i];
+        while (cls.chunks) {
+          auto* chunk = cls.chunks;
+          cls.chunks  = chunk->next;
+          chunk->next = cls.spare;
+          cls.spare   = chunk;
+        }
+        cls.free_list = nullptr;
+        cls.n_free    = 0;
+        cls.bump      = nullptr;
+        cls.bump_end   = nullptr;
+        cls.batch_left = 0;
+        cls.live       = 0;
+      }
+      live = 0;
+    }
+
+    //! Announce a batch of n allocations of the size of the next one.
+    //! Freed blocks are reused first, but if there aren't enough of them the
+    //! batch gets room in one chunk and is carved from it in order, so nodes
+    //! allocated one at a time end up in one contiguous run instead of being
+    //! spread over several chunks.
+    void reserve_next(std::size_t n) { pending = n; }
+
+    //! \return the number of pool blocks currently handed out
+    std::size_t live_blocks() const { return live; }
+
+    //! \return the number of pool blocks currently handed out for requests
+    //!         of this size and alignment, 0 if the pool passes them to the
+    //!         upstream resource
+    std::size_t live_blocks(std::size_t bytes, std::size_t alignment) const {
+      const std::size_t block_size = detail::align_up(bytes ? bytes : 1);
+      if (alignment > alignof(std::max_align_t) || block_size > max_block_size) {
+        return 0;
+      }
+      for (std::size_t i = 0; i < n_classes; ++i) {
+        if (classes[i].block_size == block_size) {
+          return classes[i].live;
+        }
+      }
+      return 0;
+    }
+
+    //! \return the number of chunks obtained from the upstream resource
+    std::size_t chunk_count() const {
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < n_classes; ++i) {
+        for (auto* chunk = classes[i].chunks; chunk; chunk = chunk->next) {
+          ++count;
+        }
+        for (auto* chunk = classes[i].spare; chunk; chunk = chunk->next) {
+          ++count;
+        }
+      }
+      return count;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const { return upstream; }
+
+  private:
+    struct FreeBlock {
+      FreeBlock* next;
+    };
+
+    struct Chunk {
+      Chunk* next;
+      std::size_t bytes;
+    };
+
+    struct SizeClass {
+      std::size_t block_size  = 0;
+      std::size_t next_blocks = 0;
+      FreeBlock* free_list    = nullptr;
+      std::size_t n_free      = 0;
+      // the chunk blocks are currently carved from, never handed out yet
+      std::byte* bump     = nullptr;
+      std::byte* bump_end = nullptr;
+      Chunk* chunks       = nullptr;// chunks in use
+      Chunk* spare        = nullptr;// recycled chunks
+      // blocks of a reserved batch still to be carved from the bump region
+      std::size_t batch_left = 0;
+      std::size_t live       = 0;// blocks handed out
+    };
+
+    static constexpr std::size_t chunk_header = detail::align_up(sizeof(Chunk));
+
+    SizeClass* find_class(std::size_t block_size) {
+      for (std::size_t i = 0; i < n_classes; ++i) {
+        if (classes[i].block_size == block_size) {
+          return &classes[i];
+        }
+      }
+      return nullptr;
+    }
+
+    void free_chunks(Chunk* chunk) noexcept {
+      while (chunk) {
+        auto* next = chunk->next;
+        upstream->deallocate(chunk, chunk->bytes, alignof(std::max_align_t));
+        chunk = next;
+      }
+    }
+
+    // Make a fresh chunk with room for at least min_blocks the bump region,
+    // reusing a recycled one if possible. What's left of the old bump region
+    // goes to the free list.
+    void grow(SizeClass& cls, std::size_t min_blocks = 1) {
+      while (static_cast<std::size_t>(cls.bump_end - cls.bump) >=
+             cls.block_size) {
+        cls.free_list = ::new (cls.bump) FreeBlock{cls.free_list};
+        ++cls.n_free;
+        cls.bump += cls.block_size;
+      }
+
+      const std::size_t min_bytes = chunk_header + min_blocks * cls.block_size;
+      Chunk* chunk                = cls.spare;
+      if (chunk && chunk->bytes >= min_bytes) {
+        cls.spare = chunk->next;
+      } else {
+        const std::size_t bytes = std::max(
+                min_bytes, chunk_header + cls.next_blocks * cls.block_size);
+        auto* raw = upstream->allocate(bytes, alignof(std::max_align_t));
+        chunk     = ::new (raw) Chunk{nullptr, bytes};
+        if (cls.next_blocks < 64 * first_chunk_blocks) {
+          cls.next_blocks *= 2;
+        }
+      }
+      chunk->next = cls.chunks;
+      cls.chunks  = chunk;
+
+      auto* base   = reinterpret_cast<std::byte*>(chunk);
+      cls.bump     = base + chunk_header;
+      cls.bump_end = base + chunk->bytes;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+      const std::size_t batch      = std::exchange(pending, 0);
+      const std::size_t block_size = detail::align_up(bytes ? bytes : 1);
+      if (alignment > alignof(std::max_align_t) || block_size > max_block_size) {
+        return upstream->allocate(bytes, alignment);
+      }
+      auto* cls = find_class(block_size);
+      if (!cls) {
+        if (n_classes == max_size_classes) {
+          return upstream->allocate(bytes, alignment);
+        }
+        cls              = &classes[n_classes++];
+        cls->block_size  = block_size;
+        cls->next_blocks = first_chunk_blocks;
+      }
+      // freed blocks are reused first, a batch only gets a run of its own
+      // when they can't hold it
+      if (batch > cls->n_free) {
+        if (static_cast<std::size_t>(cls->bump_end - cls->bump) <
+            batch * cls->block_size) {
+          grow(*cls, batch);
+        }
+        cls->batch_left = batch;
+      }
+      // a reserved batch is carved from the bump region, in order
+      if (!cls->batch_left) {
+        if (auto* block = cls->free_list) {
+          cls->free_list = block->next;
+          --cls->n_free;
+          ++cls->live;
+          ++live;
+          return block;
+        }
+      }
+      // grow can throw, nothing is counted until the block is there
+      if (static_cast<std::size_t>(cls->bump_end - cls->bump) < cls->block_size) {
+        grow(*cls);
+      }
+      if (cls->batch_left) {
+        --cls->batch_left;
+      }
+      auto* block = cls->bump;
+      cls->bump += cls->block_size;
+      ++cls->live;
+      ++live;
+      return block;
+    }
+
+    void do_deallocate(void* p, std::size_t bytes,
+                       std::size_t alignment) override {
+      const std::size_t block_size = detail::align_up(bytes ? bytes : 1);
+      SizeClass* cls               = nullptr;
+      if (alignment <= alignof(std::max_align_t) &&
+          block_size <= max_block_size) {
+        cls = find_class(block_size);
+      }
+      if (!cls) {
+        upstream->deallocate(p, bytes, alignment);
+        return;
+      }
+      cls->free_list = ::new (p) FreeBlock{cls->free_list};
+      ++cls->n_free;
+      --cls->live;
+      --live;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+
+    std::size_t first_chunk_blocks;
+    std::pmr::memory_resource* upstream;
+    SizeClass classes[max_size_classes];
+    std::size_t n_classes = 0;
+    std::size_t live      = 0;
+    std::size_t pending   = 0;// size of a batch about to start
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_POOL_HPP
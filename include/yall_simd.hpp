@@ -0,0 +1,320 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_SIMD_HPP
+#define YALL_INCLUDE_YALL_SIMD_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define YALL_SIMD_AVX2
+#define YALL_SIMD_VECTOR
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YALL_SIMD_SSE2
+#define YALL_SIMD_VECTOR
+#endif
+
+//! Vector compares over contiguous arrays of arithmetic values.
+//!  The instruction set is picked when compiling: AVX2 if the compiler
+//!  targets it (e.g. -mavx2 or -march=native), SSE2 on any other x86-64
+//!  build, plain loops elsewhere. Values compare with ==, so 0.0 matches
+//!  -0.0 and NaN matches nothing, just like the scalar loop.
+namespace yall::simd {
+  //! The value types the vector compares handle.
+  template<typename T>
+  concept Searchable = (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                         sizeof(T) == 8)) ||
+                       std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+  namespace detail {
+#if defined(YALL_SIMD_VECTOR)
+    // the register type for a value type (not std::conditional, which drops
+    // the vector attributes)
+#if defined(YALL_SIMD_AVX2)
+    template<typename T>
+    struct Register {
+      using type = __m256i;
+    };
+    template<>
+    struct Register<float> {
+      using type = __m256;
+    };
+    template<>
+    struct Register<double> {
+      using type = __m256d;
+    };
+#else
+    template<typename T>
+    struct Register {
+      using type = __m128i;
+    };
+    template<>
+    struct Register<float> {
+      using type = __m128;
+    };
+    template<>
+    struct Register<double> {
+      using type = __m128d;
+    };
+#endif
+
+    // Compares a vector's worth of values at a time with one value.
+    // equal() sets all bits of the lanes holding an equal value, operator()
+    // returns a bit per byte, the bytes of equal values are set.
+    template<typename T>
+    struct Matcher {
+#if defined(YALL_SIMD_AVX2)
+      static constexpr std::size_t bytes = 32;
+
+      explicit Matcher(T val) {
+        if constexpr (std::is_same_v<T, float>) {
+          needle = _mm256_set1_ps(val);
+        } else if constexpr (std::is_same_v<T, double>) {
+          needle = _mm256_set1_pd(val);
+        } else if constexpr (sizeof(T) == 1) {
+          needle = _mm256_set1_epi8(static_cast<char>(val));
+        } else if constexpr (sizeof(T) == 2) {
+          needle = _mm256_set1_epi16(static_cast<short>(val));
+        } else if constexpr (sizeof(T) == 4) {
+          needle = _mm256_set1_epi32(static_cast<int>(val));
+        } else {
+          needle = _mm256_set1_epi64x(static_cast<long long>(val));
+        }
+      }
+
+      __m256i equal(const T* ptr) const {
+        __m256i eq;
+        if constexpr (std::is_same_v<T, float>) {
+          eq = _mm256_castps_si256(
+                  _mm256_cmp_ps(_mm256_loadu_ps(ptr), needle, _CMP_EQ_OQ));
+        } else if constexpr (std::is_same_v<T, double>) {
+          eq = _mm256_castpd_si256(
+                  _mm256_cmp_pd(_mm256_loadu_pd(ptr), needle, _CMP_EQ_OQ));
+        } else {
+          const auto v =
+                  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+          if constexpr (sizeof(T) == 1) {
+            eq = _mm256_cmpeq_epi8(v, needle);
+          } else if constexpr (sizeof(T) == 2) {
+            eq = _mm256_cmpeq_epi16(v, needle);
+          } else if constexpr (sizeof(T) == 4) {
+            eq = _mm256_cmpeq_epi32(v, needle);
+          } else {
+            eq = _mm256_cmpeq_epi64(v, needle);
+          }
+        }
+        return eq;
+      }
+
+      std::uint32_t operator()(const T* ptr) const {
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal(ptr)));
+      }
+
+      // acc - eq, which adds 1 to the lanes that are equal
+      static __m256i tally(__m256i acc, __m256i eq) {
+        if constexpr (sizeof(T) == 1) {
+          return _mm256_sub_epi8(acc, eq);
+        } else if constexpr (sizeof(T) == 2) {
+          return _mm256_sub_epi16(acc, eq);
+        } else if constexpr (sizeof(T) == 4) {
+          return _mm256_sub_epi32(acc, eq);
+        } else {
+          return _mm256_sub_epi64(acc, eq);
+        }
+      }
+
+      using Tally = __m256i;
+      static Tally no_tally() { return _mm256_setzero_si256(); }
+#else
+      static constexpr std::size_t bytes = 16;
+
+      explicit Matcher(T val) {
+        if constexpr (std::is_same_v<T, float>) {
+          needle = _mm_set1_ps(val);
+        } else if constexpr (std::is_same_v<T, double>) {
+          needle = _mm_set1_pd(val);
+        } else if constexpr (sizeof(T) == 1) {
+          needle = _mm_set1_epi8(static_cast<char>(val));
+        } else if constexpr (sizeof(T) == 2) {
+          needle = _mm_set1_epi16(static_cast<short>(val));
+        } else if constexpr (sizeof(T) == 4) {
+          needle = _mm_set1_epi32(static_cast<int>(val));
+        } else {
+          needle = _mm_set1_epi64x(static_cast<long long>(val));
+        }
+      }
+
+      __m128i equal(const T* ptr) const {
+        __m128i eq;
+        if constexpr (std::is_same_v<T, float>) {
+          eq = _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(ptr), needle));
+        } else if constexpr (std::is_same_v<T, double>) {
+          eq = _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(ptr), needle));
+        } else {
+          const auto v =
+                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+          if constexpr (sizeof(T) == 1) {
+            eq = _mm_cmpeq_epi8(v, needle);
+          } else if constexpr (sizeof(T) == 2) {
+            eq = _mm_cmpeq_epi16(v, needle);
+          } else if constexpr (sizeof(T) == 4) {
+            eq = _mm_cmpeq_epi32(v, needle);
+          } else {
+            // SSE2 has no 64 bit compare: both 32 bit halves must match
+            eq = _mm_cmpeq_epi32(v, needle);
+            eq = _mm_and_si128(eq,
+                               _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+          }
+        }
+        return eq;
+      }
+
+      std::uint32_t operator()(const T* ptr) const {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(equal(ptr)));
+      }
+
+      // acc - eq, which adds 1 to the lanes that are equal
+      static __m128i tally(__m128i acc, __m128i eq) {
+        if constexpr (sizeof(T) == 1) {
+          return _mm_sub_epi8(acc, eq);
+        } else if constexpr (sizeof(T) == 2) {
+          return _mm_sub_epi16(acc, eq);
+        } else if constexpr (sizeof(T) == 4) {
+          return _mm_sub_epi32(acc, eq);
+        } else {
+          return _mm_sub_epi64(acc, eq);
+        }
+      }
+
+      using Tally = __m128i;
+      static Tally no_tally() { return _mm_setzero_si128(); }
+#endif
+      static constexpr std::size_t lanes = bytes / sizeof(T);
+      // rounds of tally before a lane can overflow
+      static constexpr std::size_t max_tally =
+              sizeof(T) == 1 ? 255 : sizeof(T) == 2 ? 65535 : ~std::size_t{0};
+
+      // sum of the lanes of a tally
+      static std::size_t total(Tally acc) {
+        using Lane = std::make_unsigned_t<
+                std::conditional_t<std::is_integral_v<T>, T,
+                                   std::conditional_t<sizeof(T) == 4,
+                                                      std::uint32_t,
+                                                      std::uint64_t>>>;
+        Lane lane[lanes];
+        std::memcpy(lane, &acc, sizeof(acc));
+        std::size_t sum = 0;
+        for (auto l: lane) {
+          sum += l;
+        }
+        return sum;
+      }
+
+      typename Register<T>::type needle;
+    };
+#endif
+  }// namespace detail
+
+  //! The width of the vector compares in bytes, 0 for plain loops.
+#if defined(YALL_SIMD_AVX2)
+  inline constexpr std::size_t vector_bytes = 32;
+#elif defined(YALL_SIMD_SSE2)
+  inline constexpr std::size_t vector_bytes = 16;
+#else
+  inline constexpr std::size_t vector_bytes = 0;
+#endif
+
+  //! \return the index of the first value in [data, data + n) equal to val,
+  //!         or n if there is none
+  template<Searchable T>
+  std::size_t find(const T* data, std::size_t n, T val) {
+    std::size_t i = 0;
+#if defined(YALL_SIMD_VECTOR)
+    using Matcher = detail::Matcher<T>;
+    const Matcher match(val);
+    for (; i + Matcher::lanes <= n; i += Matcher::lanes) {
+      if (const auto mask = match(data + i)) {
+        const auto low = static_cast<std::size_t>(std::countr_zero(mask));
+        return i + low / sizeof(T);
+      }
+    }
+#endif
+    for (; i < n; ++i) {
+      if (data[i] == val) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  //! \return the index of the last value in [data, data + n) equal to val,
+  //!         or n if there is none
+  template<Searchable T>
+  std::size_t rfind(const T* data, std::size_t n, T val) {
+    std::size_t i = n;
+#if defined(YALL_SIMD_VECTOR)
+    using Matcher = detail::Matcher<T>;
+    const Matcher match(val);
+    for (; i >= Matcher::lanes; i -= Matcher::lanes) {
+      if (const auto mask = match(data + i - Matcher::lanes)) {
+        const auto top = static_cast<std::size_t>(std::bit_width(mask)) - 1;
+        return i - Matcher::lanes + top / sizeof(T);
+      }
+    }
+#endif
+    while (i-- > 0) {
+      if (data[i] == val) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  //! \return the number of values in [data, data + n) equal to val
+  template<Searchable T>
+  std::size_t count(const T* data, std::size_t n, T val) {
+    std::size_t i     = 0;
+    std::size_t found = 0;
+#if defined(YALL_SIMD_VECTOR)
+    // count in the lanes of a register, there is no popcount without
+    // -mpopcnt
+    using Matcher = detail::Matcher<T>;
+    const Matcher match(val);
+    while (i + Matcher::lanes <= n) {
+      auto acc = Matcher::no_tally();
+      for (std::size_t r = 0; r < Matcher::max_tally && i + Matcher::lanes <= n;
+           ++r, i += Matcher::lanes) {
+        acc = Matcher::tally(acc, match.equal(data + i));
+      }
+      found += Matcher::total(acc);
+    }
+#endif
+    for (; i < n; ++i) {
+      found += data[i] == val;
+    }
+    return found;
+  }
+}// namespace yall::simd
+
+#endif//YALL_INCLUDE_YALL_SIMD_HPP
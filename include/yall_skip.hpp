@@ -0,0 +1,575 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_SKIP_HPP
+#define YALL_INCLUDE_YALL_SKIP_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace yall {
+
+  //! Doubly linked-list with positional access, an indexable skip list.
+  //!  Every node is on the usual doubly linked chain, which is what the
+  //!  iterators walk. About a quarter of the nodes are also on a first
+  //!  express lane, a quarter of those on a second one, and so on. Each
+  //!  express link records its width, the number of positions it skips, so
+  //!  a position is found by running down the lanes like a skip list search.
+  //!  at, insert_at, erase_at and rank are expected O(log n); so are
+  //!  push_back and push_front, which find their position the same way.
+  //!
+  //!  Three nodes out of four carry no lanes at all, the others an array of
+  //!  (next, width) pairs. Only value types can be stored.
+  //!
+  //!* \tparam T The type of the node data.
+  template<typename T>
+  class SkipYall final {
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "SkipYall stores values, use Yall for references");
+
+    // lane 0 is the chain itself, so there are at most max_height - 1
+    // express lanes
+    static constexpr int max_height = 32;
+
+    struct Node;
+
+    // an express link, width counts the positions it moves forward; a null
+    // link reaches one past the back of the list
+    struct Lane {
+      Node* next        = nullptr;
+      std::size_t width = 0;
+    };
+
+    struct Node {
+      template<class... Args>
+      explicit Node(std::in_place_t, Args&&... args)
+          : data(std::forward<Args>(args)...) {}
+
+      T data;
+      Node* prev = nullptr;
+      std::unique_ptr<Node> next;
+      // express lanes 1 .. height - 1, none for most nodes
+      std::unique_ptr<Lane[]> lanes;
+      int height = 1;
+    };
+    using NodePtr = std::unique_ptr<Node>;
+
+    // the last node before a position on each express lane, and its rank
+    struct Preds {
+      std::array<Node*, max_height> node;
+      std::array<std::size_t, max_height> rank;
+    };
+
+    // express lane l of a node, null standing for the front of the list
+    Lane& lane(Node* node, int l) {
+      return node ? node->lanes[l - 1] : front_lanes[l - 1];
+    }
+    const Lane& lane(const Node* node, int l) const {
+      return node ? node->lanes[l - 1] : front_lanes[l - 1];
+    }
+
+    Node* next_of(Node* node) const {
+      return node ? node->next.get() : head.get();
+    }
+
+    // Run down the lanes to the node before pos, a 1-based position (the
+    // front of the list is position 0). Fills preds if given.
+    // \return the node before pos, null for the front
+    Node* find_before(std::size_t pos, Preds* preds) const {
+      Node* node     = nullptr;
+      std::size_t at = 0;
+      for (int l = levels - 1; l >= 1; --l) {
+        for (auto* ln = &lane(node, l); ln->next && at + ln->width < pos;
+             ln      = &lane(node, l)) {
+          at += ln->width;
+          node = ln->next;
+        }
+        if (preds) {
+          preds->node[l] = node;
+          preds->rank[l] = at;
+        }
+      }
+      for (; at + 1 < pos; ++at) {
+        node = next_of(node);
+      }
+      return node;
+    }
+
+    Node* node_at(std::size_t indx) const {
+      return next_of(find_before(indx + 1, nullptr));
+    }
+
+    // 1 + the number of express lanes of a new node: each further lane
+    // with a chance of 1/4
+    int random_height() {
+      // xorshift64*
+      seed ^= seed >> 12;
+      seed ^= seed << 25;
+      seed ^= seed >> 27;
+      const auto bits = seed * 0x2545F4914F6CDD1DULL;
+      return 1 + std::countr_zero(bits | (std::uint64_t{1} << 62)) / 2;
+    }
+
+    // link a new node so that it ends up at position indx (at the back if
+    // that's past the end)
+    template<class... Args>
+    Node* link_at(std::size_t indx, Args&&... args) {
+      const std::size_t pos = std::min(indx, count) + 1;
+      auto node             = std::make_unique<Node>(std::in_place,
+                                                     std::forward<Args>(args)...);
+      auto* ptr             = node.get();
+      const int h           = random_height();
+      if (h > 1) {
+        ptr->lanes  = std::make_unique<Lane[]>(h - 1);
+        ptr->height = h;
+      }
+
+      Preds preds;
+      auto* pred = find_before(pos, &preds);
+      for (; levels < h; ++levels) {
+        preds.node[levels]      = nullptr;
+        preds.rank[levels]      = 0;
+        front_lanes[levels - 1] = {nullptr, count + 1};
+      }
+
+      NodePtr& slot = pred ? pred->next : head;
+      ptr->prev     = pred;
+      ptr->next     = std::move(slot);
+      if (ptr->next) {
+        ptr->next->prev = ptr;
+      } else {
+        tail = ptr;
+      }
+      slot = std::move(node);
+
+      for (int l = 1; l < levels; ++l) {
+        Lane& from = lane(preds.node[l], l);
+        if (l < h) {
+          const std::size_t skip = pos - preds.rank[l];
+          ptr->lanes[l - 1]      = {from.next, from.width + 1 - skip};
+          from                   = {ptr, skip};
+        } else {
+          ++from.width;
+        }
+      }
+      ++count;
+      return ptr;
+    }
+
+    // unlink the node at the 1-based position pos and hand it over
+    NodePtr unlink_at(std::size_t pos) {
+      Preds preds;
+      auto* pred   = find_before(pos, &preds);
+      auto* victim = next_of(pred);
+      for (int l = 1; l < levels; ++l) {
+        Lane& from = lane(preds.node[l], l);
+        if (from.next == victim) {
+          const Lane& gone = victim->lanes[l - 1];
+          from             = {gone.next, from.width + gone.width - 1};
+        } else {
+          --from.width;
+        }
+      }
+      while (levels > 1 && !front_lanes[levels - 2].next) {
+        --levels;
+      }
+
+      NodePtr& slot = pred ? pred->next : head;
+      auto node     = std::move(slot);
+      slot          = std::move(node->next);
+      if (slot) {
+        slot->prev = pred;
+      } else {
+        tail = pred;
+      }
+      --count;
+      return node;
+    }
+
+    // The index of a node: from the node, keep taking its highest lane,
+    // counting the positions to the back of the list. The heights met only
+    // go up, so it is the search path in reverse.
+    std::size_t rank_of(const Node* node) const {
+      std::size_t to_back = 0;
+      while (node) {
+        if (node->height > 1) {
+          const Lane& top = node->lanes[node->height - 2];
+          to_back += top.width;
+          node = top.next;
+        } else {
+          ++to_back;
+          node = node->next.get();
+        }
+      }
+      return count - to_back;
+    }
+
+  public:
+    SkipYall() = default;
+    ~SkipYall() { reset(); }
+
+    SkipYall(const SkipYall&)            = delete;
+    SkipYall& operator=(const SkipYall&) = delete;
+
+    SkipYall(SkipYall&& other) noexcept { steal(other); }
+
+    SkipYall& operator=(SkipYall&& other) noexcept {
+      if (this != &other) {
+        reset();
+        steal(other);
+      }
+      return *this;
+    }
+
+    //! Insert a new node at the front of the list.
+    //! \param data node value
+    void push_front(const T& data) { emplace_front(data); }
+    void push_front(T&& data) { emplace_front(std::move(data)); }
+
+    //! Construct a new node value in place at the front of the list.
+    //! \return the new value
+    template<class... Args>
+    T& emplace_front(Args&&... args) {
+      return link_at(0, std::forward<Args>(args)...)->data;
+    }
+
+    //! Insert a new node at the back of the list.
+    //! \param data node value
+    void push_back(const T& data) { emplace_back(data); }
+    void push_back(T&& data) { emplace_back(std::move(data)); }
+
+    //! Construct a new node value in place at the back of the list.
+    //! \return the new value
+    template<class... Args>
+    T& emplace_back(Args&&... args) {
+      return link_at(count, std::forward<Args>(args)...)->data;
+    }
+
+    //! Removes the first element in the linked list
+    void pop_front() { erase_at(0); }
+
+    //! Removes the last element in the linked list.
+    void pop_back() {
+      if (count) {
+        erase_at(count - 1);
+      }
+    }
+
+    //! Remove the first element, moving its value out.
+    //! \return the value that was at the front of the list, or none.
+    std::optional<T> pop_front_value() {
+      if (!count) {
+        return {};
+      }
+      return std::optional<T>(std::move(unlink_at(1)->data));
+    }
+
+    //! Remove the last element, moving its value out.
+    //! \return the value that was at the back of the list, or none.
+    std::optional<T> pop_back_value() {
+      if (!count) {
+        return {};
+      }
+      return std::optional<T>(std::move(unlink_at(count)->data));
+    }
+
+    //! \return a copy of the value at the front of the list, or none.
+    std::optional<T> front_val() const {
+      if (head) {
+        return head->data;
+      }
+      return {};
+    }
+
+    //! \return a copy of the value at the back of the list, or none.
+    std::optional<T> back_val() const {
+      if (tail) {
+        return tail->data;
+      }
+      return {};
+    }
+
+    //! Get the value at the front of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool front(T& ref) const {
+      if (head) {
+        ref = head->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Get the value at the back of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool back(T& ref) const {
+      if (tail) {
+        ref = tail->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! The value at position indx, expected O(log n).
+    //! \throw std::out_of_range if indx isn't less than size()
+    T& at(std::size_t indx) {
+      if (indx >= count) {
+        throw std::out_of_range("yall::SkipYall::at");
+      }
+      return node_at(indx)->data;
+    }
+
+    const T& at(std::size_t indx) const {
+      if (indx >= count) {
+        throw std::out_of_range("yall::SkipYall::at");
+      }
+      return node_at(indx)->data;
+    }
+
+    //! Insert a new value so that it ends up at position indx, or at the back
+    //! of the list if indx is past the end, expected O(log n).
+    void insert_at(std::size_t indx, const T& new_val) {
+      emplace_at(indx, new_val);
+    }
+
+    void insert_at(std::size_t indx, T&& new_val) {
+      emplace_at(indx, std::move(new_val));
+    }
+
+    //! Construct a new value in place at position indx, or at the back of
+    //! the list if indx is past the end.
+    //! \param args arguments for the T constructor
+    //! \return the new value
+    template<class... Args>
+    T& emplace_at(std::size_t indx, Args&&... args) {
+      return link_at(indx, std::forward<Args>(args)...)->data;
+    }
+
+    //! Remove the value at position indx, expected O(log n).
+    //! \return true if there was a value at indx, otherwise false
+    bool erase_at(std::size_t indx) {
+      if (indx >= count) {
+        return false;
+      }
+      unlink_at(indx + 1);
+      return true;
+    }
+
+    //! Start from the front of the list, find the first match, and remove it.
+    //!  The search is a walk, the removal expected O(log n).
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_first(const T& match_val) {
+      std::size_t indx = 0;
+      for (auto* ptr = head.get(); ptr; ptr = ptr->next.get(), ++indx) {
+        if (ptr->data == match_val) {
+          unlink_at(indx + 1);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //! Start from the back of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_last(const T& match_val) {
+      std::size_t pos = count;
+      for (auto* ptr = tail; ptr; ptr = ptr->prev, --pos) {
+        if (ptr->data == match_val) {
+          unlink_at(pos);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //! \return whether the value is in the list, a walk
+    bool contains(const T& match_val) const {
+      for (auto* ptr = head.get(); ptr; ptr = ptr->next.get()) {
+        if (ptr->data == match_val) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    using PrinterCB = std::function<void(const T&)>;
+
+    //! Print the values in the list, front-to-back.
+    //!
+    //! \param printer_cb callback that will print node data to stdout
+    void print(PrinterCB printer_cb) const {
+      for (auto* ptr = head.get(); ptr; ptr = ptr->next.get()) {
+        printer_cb(ptr->data);
+      }
+      std::cout << "|-\n";// list display "null-terminator"
+    }
+
+    //! Free all nodes (create an empty list), one node at a time.
+    void reset() noexcept {
+      while (head) {
+        head = std::move(head->next);
+      }
+      tail   = nullptr;
+      count  = 0;
+      levels = 1;
+    }
+
+    //! \return whether the list is empty
+    bool empty() const { return count == 0; }
+
+    //! \return the number of elements
+    std::size_t size() const { return count; }
+
+    //! Bidirectional iterator, stepping past either end gives the end
+    //! iterator (the same for both directions).
+    template<bool IsConst>
+    struct BasicIterator {
+      // iterator traits
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type        = T;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      explicit BasicIterator() : node(nullptr) {}
+
+      template<bool OtherConst>
+        requires(IsConst && !OtherConst)
+      BasicIterator(const BasicIterator<OtherConst>& other)
+          : node(other.node) {}
+
+      reference operator*() const { return node->data; }
+      pointer operator->() const { return &node->data; }
+
+      BasicIterator& operator++() {
+        node = node->next.get();
+        return *this;
+      }
+
+      BasicIterator operator++(int) {
+        BasicIterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      BasicIterator& operator--() {
+        node = node->prev;
+        return *this;
+      }
+
+      BasicIterator operator--(int) {
+        BasicIterator tmp = *this;
+        --(*this);
+        return tmp;
+      }
+
+      friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+        return a.node == b.node;
+      };
+      friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+        return a.node != b.node;
+      };
+
+    private:
+      friend class SkipYall;
+      friend struct BasicIterator<!IsConst>;
+
+      explicit BasicIterator(Node* node_) : node(node_) {}
+
+      Node* node;
+    };
+
+    using Iterator      = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    ConstIterator cbegin() const { return ConstIterator(head.get()); }
+    ConstIterator cend() const { return ConstIterator(); }
+    Iterator begin() { return Iterator(head.get()); }
+    Iterator end() { return Iterator(); }
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+    ConstIterator crbegin() const { return ConstIterator(tail); }
+    ConstIterator crend() const { return ConstIterator(); }
+
+    //! \return an iterator to the value at position indx, or the end
+    //!         iterator past the end of the list, expected O(log n)
+    Iterator iter_at(std::size_t indx) {
+      return Iterator(indx < count ? node_at(indx) : nullptr);
+    }
+
+    //! \return the position of the value at pos, or size() for the end
+    //!         iterator, expected O(log n)
+    std::size_t rank(ConstIterator pos) const { return rank_of(pos.node); }
+
+    //! Insert a new value in front of pos (at the back for the end iterator).
+    //! \return an iterator to the new value
+    Iterator insert(ConstIterator pos, const T& new_val) {
+      return emplace(pos, new_val);
+    }
+
+    Iterator insert(ConstIterator pos, T&& new_val) {
+      return emplace(pos, std::move(new_val));
+    }
+
+    //! Construct a new value in place in front of pos (at the back for the
+    //! end iterator).
+    //! \return an iterator to the new value
+    template<class... Args>
+    Iterator emplace(ConstIterator pos, Args&&... args) {
+      return Iterator(link_at(rank(pos), std::forward<Args>(args)...));
+    }
+
+    //! Remove the value at pos, which must be dereferenceable.
+    //! \return an iterator to the value that followed the removed one
+    Iterator erase(ConstIterator pos) {
+      auto* next = pos.node->next.get();
+      unlink_at(rank(pos) + 1);
+      return Iterator(next);
+    }
+
+  private:
+    void steal(SkipYall& other) noexcept {
+      head        = std::move(other.head);
+      tail        = std::exchange(other.tail, nullptr);
+      count       = std::exchange(other.count, 0);
+      levels      = std::exchange(other.levels, 1);
+      front_lanes = other.front_lanes;
+      seed        = other.seed;
+    }
+
+    NodePtr head;
+    Node* tail        = nullptr;
+    std::size_t count = 0;
+    // lanes in use, counting the chain itself
+    int levels = 1;
+    std::array<Lane, max_height - 1> front_lanes{};
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_SKIP_HPP
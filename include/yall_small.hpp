@@ -0,0 +1,496 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_SMALL_HPP
+#define YALL_INCLUDE_YALL_SMALL_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace yall {
+
+  //! Doubly linked-list with room for its first N nodes inside the list
+  //!  object. Nodes go into a free inline slot when there is one and onto
+  //!  the heap otherwise, so a list that never holds more than N values
+  //!  never allocates. Slots freed by pop/remove calls are used again by the
+  //!  next insertion, wherever in the list it lands.
+  //!
+  //!  The list object is N nodes bigger than a Yall. Moving a list hands
+  //!  over its heap nodes but has to move the values held inline, so moves
+  //!  walk the list when it has inline nodes, and values in the inline
+  //!  slots don't keep their address. Only value types can be stored.
+  //!
+  //!* \tparam T The type of the node data.
+  //!* \tparam N The number of nodes kept inline, at most 64.
+  template<typename T, std::size_t N = 8>
+  class SmallYall final {
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "SmallYall stores values, use Yall for references");
+    static_assert(N > 0 && N <= 64, "SmallYall keeps 1 to 64 nodes inline");
+
+    struct Node {
+      template<class... Args>
+      explicit Node(std::in_place_t, Args&&... args)
+          : data(std::forward<Args>(args)...) {}
+
+      T data;
+      Node* prev = nullptr;
+      Node* next = nullptr;
+    };
+
+    // a set bit per free inline slot
+    static constexpr std::uint64_t all_free =
+            N == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << N) - 1;
+
+    Node* slot(std::size_t i) {
+      return reinterpret_cast<Node*>(storage + i * sizeof(Node));
+    }
+
+    bool is_inline(const Node* node) const {
+      const auto* byte = reinterpret_cast<const std::byte*>(node);
+      std::less_equal<const std::byte*> le;
+      return le(storage, byte) && !le(storage + sizeof(storage), byte);
+    }
+
+    template<class... Args>
+    Node* make_node(Args&&... args) {
+      if (free_slots) {
+        const auto i = std::countr_zero(free_slots);
+        auto* node = std::construct_at(slot(i), std::in_place,
+                                       std::forward<Args>(args)...);
+        free_slots &= ~(std::uint64_t{1} << i);
+        return node;
+      }
+      return new Node(std::in_place, std::forward<Args>(args)...);
+    }
+
+    void free_node(Node* node) noexcept {
+      if (is_inline(node)) {
+        const auto i = (reinterpret_cast<std::byte*>(node) - storage) /
+                       sizeof(Node);
+        std::destroy_at(node);
+        free_slots |= std::uint64_t{1} << i;
+      } else {
+        delete node;
+      }
+    }
+
+    // link node in front of succ (at the back for null)
+    Node* link_before(Node* succ, Node* node) {
+      Node* pred = succ ? succ->prev : tail;
+      node->prev = pred;
+      node->next = succ;
+      (pred ? pred->next : head) = node;
+      (succ ? succ->prev : tail) = node;
+      ++count;
+      return node;
+    }
+
+    // unlink and free the node
+    // \return the node that followed it
+    Node* unlink(Node* node) noexcept {
+      Node* next = node->next;
+      (node->prev ? node->prev->next : head) = next;
+      (next ? next->prev : tail)             = node->prev;
+      --count;
+      free_node(node);
+      return next;
+    }
+
+    Node* find_node(const T& match_val) const {
+      for (auto* ptr = head; ptr; ptr = ptr->next) {
+        if (ptr->data == match_val) {
+          return ptr;
+        }
+      }
+      return nullptr;
+    }
+
+    Node* rfind_node(const T& match_val) const {
+      for (auto* ptr = tail; ptr; ptr = ptr->prev) {
+        if (ptr->data == match_val) {
+          return ptr;
+        }
+      }
+      return nullptr;
+    }
+
+  public:
+    //! The number of nodes kept inside the list object.
+    static constexpr std::size_t inline_capacity = N;
+
+    SmallYall() = default;
+    ~SmallYall() { reset(); }
+
+    SmallYall(const SmallYall&)            = delete;
+    SmallYall& operator=(const SmallYall&) = delete;
+
+    SmallYall(SmallYall&& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>) {
+      steal(other);
+    }
+
+    SmallYall& operator=(SmallYall&& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>) {
+      if (this != &other) {
+        reset();
+        steal(other);
+      }
+      return *this;
+    }
+
+    //! Insert a new node at the front of the list.
+    //! \param data node value
+    void push_front(const T& data) { emplace_front(data); }
+    void push_front(T&& data) { emplace_front(std::move(data)); }
+
+    //! Construct a new node value in place at the front of the list.
+    //! \return the new value
+    template<class... Args>
+    T& emplace_front(Args&&... args) {
+      return link_before(head, make_node(std::forward<Args>(args)...))->data;
+    }
+
+    //! Insert a new node at the back of the list.
+    //! \param data node value
+    void push_back(const T& data) { emplace_back(data); }
+    void push_back(T&& data) { emplace_back(std::move(data)); }
+
+    //! Construct a new node value in place at the back of the list.
+    //! \return the new value
+    template<class... Args>
+    T& emplace_back(Args&&... args) {
+      return link_before(nullptr, make_node(std::forward<Args>(args)...))
+              ->data;
+    }
+
+    //! Removes the first element in the linked list
+    void pop_front() {
+      if (head) {
+        unlink(head);
+      }
+    }
+
+    //! Removes the last element in the linked list.
+    void pop_back() {
+      if (tail) {
+        unlink(tail);
+      }
+    }
+
+    //! Remove the first element, moving its value out.
+    //! \return the value that was at the front of the list, or none.
+    std::optional<T> pop_front_value() {
+      if (!head) {
+        return {};
+      }
+      std::optional<T> val(std::move(head->data));
+      unlink(head);
+      return val;
+    }
+
+    //! Remove the last element, moving its value out.
+    //! \return the value that was at the back of the list, or none.
+    std::optional<T> pop_back_value() {
+      if (!tail) {
+        return {};
+      }
+      std::optional<T> val(std::move(tail->data));
+      unlink(tail);
+      return val;
+    }
+
+    //! \return a copy of the value at the front of the list, or none.
+    std::optional<T> front_val() const {
+      if (head) {
+        return head->data;
+      }
+      return {};
+    }
+
+    //! \return a copy of the value at the back of the list, or none.
+    std::optional<T> back_val() const {
+      if (tail) {
+        return tail->data;
+      }
+      return {};
+    }
+
+    //! Get the value at the front of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool front(T& ref) const {
+      if (head) {
+        ref = head->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Get the value at the back of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool back(T& ref) const {
+      if (tail) {
+        ref = tail->data;
+        return true;
+      }
+      return false;
+    }
+
+    //! Start from the front of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_first(const T& match_val) {
+      if (auto* ptr = find_node(match_val)) {
+        unlink(ptr);
+        return true;
+      }
+      return false;
+    }
+
+    //! Start from the back of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_last(const T& match_val) {
+      if (auto* ptr = rfind_node(match_val)) {
+        unlink(ptr);
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value before that
+    //! @return true if the new value has been inserted into the list
+    bool insert_before(const T& match_val, const T& new_val) {
+      if (auto* ptr = find_node(match_val)) {
+        link_before(ptr, make_node(new_val));
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value after that
+    //! @return true if the new value has been inserted into the list
+    bool insert_after(const T& match_val, const T& new_val) {
+      if (auto* ptr = find_node(match_val)) {
+        link_before(ptr->next, make_node(new_val));
+        return true;
+      }
+      return false;
+    }
+
+    //! Insert a new value so that it ends up at position indx, or at the back
+    //! of the list if indx is past the end.
+    void insert_at(std::size_t indx, const T& new_val) {
+      emplace_at(indx, new_val);
+    }
+
+    void insert_at(std::size_t indx, T&& new_val) {
+      emplace_at(indx, std::move(new_val));
+    }
+
+    //! Construct a new value in place at position indx, or at the back of
+    //! the list if indx is past the end.
+    //! \param args arguments for the T constructor
+    //! \return the new value
+    template<class... Args>
+    T& emplace_at(std::size_t indx, Args&&... args) {
+      auto* succ = head;
+      for (; succ && indx > 0; --indx) {
+        succ = succ->next;
+      }
+      return link_before(succ, make_node(std::forward<Args>(args)...))->data;
+    }
+
+    using PrinterCB = std::function<void(const T&)>;
+
+    //! Print the values in the list, front-to-back.
+    //!
+    //! \param printer_cb callback that will print node data to stdout
+    void print(PrinterCB printer_cb) const {
+      for (auto* ptr = head; ptr; ptr = ptr->next) {
+        printer_cb(ptr->data);
+      }
+      std::cout << "|-\n";// list display "null-terminator"
+    }
+
+    //! Free all nodes (create an empty list).
+    void reset() noexcept {
+      while (head) {
+        free_node(std::exchange(head, head->next));
+      }
+      tail       = nullptr;
+      count      = 0;
+      free_slots = all_free;
+    }
+
+    //! \return whether the list is empty
+    bool empty() const { return count == 0; }
+
+    //! \return the number of elements
+    std::size_t size() const { return count; }
+
+    //! \return the number of nodes held inside the list object, the rest
+    //!         are on the heap
+    std::size_t inline_nodes() const {
+      return N - static_cast<std::size_t>(std::popcount(free_slots));
+    }
+
+    //! Bidirectional iterator, stepping past either end gives the end
+    //! iterator (the same for both directions).
+    template<bool IsConst>
+    struct BasicIterator {
+      // iterator traits
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type        = T;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      explicit BasicIterator() : node(nullptr) {}
+
+      template<bool OtherConst>
+        requires(IsConst && !OtherConst)
+      BasicIterator(const BasicIterator<OtherConst>& other)
+          : node(other.node) {}
+
+      reference operator*() const { return node->data; }
+      pointer operator->() const { return &node->data; }
+
+      BasicIterator& operator++() {
+        node = node->next;
+        return *this;
+      }
+
+      BasicIterator operator++(int) {
+        BasicIterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      BasicIterator& operator--() {
+        node = node->prev;
+        return *this;
+      }
+
+      BasicIterator operator--(int) {
+        BasicIterator tmp = *this;
+        --(*this);
+        return tmp;
+      }
+
+      friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+        return a.node == b.node;
+      };
+      friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+        return a.node != b.node;
+      };
+
+    private:
+      friend class SmallYall;
+      friend struct BasicIterator<!IsConst>;
+
+      explicit BasicIterator(Node* node_) : node(node_) {}
+
+      Node* node;
+    };
+
+    using Iterator      = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    ConstIterator cbegin() const { return ConstIterator(head); }
+    ConstIterator cend() const { return ConstIterator(); }
+    Iterator begin() { return Iterator(head); }
+    Iterator end() { return Iterator(); }
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+    ConstIterator crbegin() const { return ConstIterator(tail); }
+    ConstIterator crend() const { return ConstIterator(); }
+
+    //! Start from the front of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator find(const T& match_val) { return Iterator(find_node(match_val)); }
+
+    //! Start from the back of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator rfind(const T& match_val) {
+      return Iterator(rfind_node(match_val));
+    }
+
+    //! Insert a new value in front of pos (at the back for the end iterator).
+    //! \return an iterator to the new value
+    Iterator insert(ConstIterator pos, const T& new_val) {
+      return emplace(pos, new_val);
+    }
+
+    Iterator insert(ConstIterator pos, T&& new_val) {
+      return emplace(pos, std::move(new_val));
+    }
+
+    //! Construct a new value in place in front of pos (at the back for the
+    //! end iterator).
+    //! \return an iterator to the new value
+    template<class... Args>
+    Iterator emplace(ConstIterator pos, Args&&... args) {
+      return Iterator(
+              link_before(pos.node, make_node(std::forward<Args>(args)...)));
+    }
+
+    //! Remove the value at pos, which must be dereferenceable.
+    //! \return an iterator to the value that followed the removed one
+    Iterator erase(ConstIterator pos) { return Iterator(unlink(pos.node)); }
+
+  private:
+    // take over the nodes of other, which is left empty; this list must be
+    // empty, so the inline nodes of other all fit in its slots
+    void steal(SmallYall& other) noexcept(
+            std::is_nothrow_move_constructible_v<T>) {
+      if (other.free_slots == all_free) {
+        head  = std::exchange(other.head, nullptr);
+        tail  = std::exchange(other.tail, nullptr);
+        count = std::exchange(other.count, 0);
+        return;
+      }
+      while (other.head) {
+        Node* node  = other.head;
+        Node* moved = other.is_inline(node) ? make_node(std::move(node->data))
+                                            : node;
+        other.head = node->next;
+        (other.head ? other.head->prev : other.tail) = nullptr;
+        --other.count;
+        if (moved != node) {
+          other.free_node(node);
+        }
+        link_before(nullptr, moved);
+      }
+    }
+
+    Node* head        = nullptr;
+    Node* tail        = nullptr;
+    std::size_t count = 0;
+    std::uint64_t free_slots = all_free;
+    alignas(Node) std::byte storage[N * sizeof(Node)];
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_SMALL_HPP
@@ -0,0 +1,183 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_STATS_HPP
+#define YALL_INCLUDE_YALL_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace yall {
+
+  //! The list operations statistics are kept for.
+  enum class Op : std::uint8_t {
+    push_front,
+    push_back,
+    pop_front,
+    pop_back,
+    remove_first,
+    remove_last,
+    insert_before,
+    insert_after,
+    insert_at,
+    find,
+    rfind,
+    insert,
+    erase,
+    insert_range,
+    splice,
+    merge,
+    sort,
+    for_each,
+    visit_until,
+    remove_if,
+    unique,
+    size,
+    reset,
+    count_
+  };
+
+  inline constexpr std::size_t op_count = static_cast<std::size_t>(Op::count_);
+
+  //! \return the name of the operation, e.g. "remove_first"
+  constexpr const char* op_name(Op op) {
+    constexpr const char* names[] = {
+            "push_front",   "push_back",    "pop_front", "pop_back",
+            "remove_first", "remove_last",  "insert_before",
+            "insert_after", "insert_at",    "find",      "rfind",
+            "insert",       "erase",        "insert_range",
+            "splice",       "merge",        "sort",      "for_each",
+            "visit_until",  "remove_if",    "unique",    "size",
+            "reset"};
+    static_assert(std::size(names) == op_count);
+    return names[static_cast<std::size_t>(op)];
+  }
+
+  //! Called after every recorded operation with the number of nodes it
+  //! visited.
+  using StatsCallback = std::function<void(Op, std::size_t)>;
+
+  //! Calls to one operation and the nodes they visited.
+  struct OpStats {
+    //! bucket 0 counts the calls that visited no node, bucket b > 0 those
+    //! that visited [2^(b-1), 2^b) nodes
+    static constexpr std::size_t buckets = 33;
+
+    std::uint64_t calls   = 0;
+    std::uint64_t visited = 0;
+    std::array<std::uint64_t, buckets> histogram{};
+
+    static constexpr std::size_t bucket_of(std::size_t n) {
+      return std::min<std::size_t>(std::bit_width(n), buckets - 1);
+    }
+  };
+
+  //! Everything a CountingStats has recorded.
+  struct StatsSnapshot {
+    std::array<OpStats, op_count> ops{};
+    //! nodes created and destroyed by the list
+    std::uint64_t allocations = 0;
+    std::uint64_t frees       = 0;
+    //! nodes held by the list now and at most, nodes spliced in or out count
+    std::uint64_t live_nodes = 0;
+    std::uint64_t peak_nodes = 0;
+    //! reference count updates made by the ownership policy when linking
+    //! (always 0 for UniqueOwnership)
+    std::uint64_t ref_updates = 0;
+
+    const OpStats& operator[](Op op) const {
+      return ops[static_cast<std::size_t>(op)];
+    }
+  };
+
+  //! Stats policy that records nothing, the default.
+  //!  It is empty and stored with [[no_unique_address]], and every hook is
+  //!  behind `if constexpr (Stats::enabled)`, so a list with it is the same
+  //!  size and runs the same code as one without statistics.
+  struct NoStats {
+    static constexpr bool enabled = false;
+  };
+
+  //! Stats policy that counts the calls to every operation, the nodes each
+  //! call visited (total and histogram), node allocations and frees, live
+  //! and peak nodes, and reference count updates.
+  //!  A callback can be set to see every operation as it completes, except
+  //!  those that can't throw (the list's reset() and destructor), which are
+  //!  only counted. Like the list itself it isn't thread-safe.
+  class CountingStats {
+  public:
+    static constexpr bool enabled = true;
+
+    using Callback = StatsCallback;
+
+    void on_op(Op op, std::size_t visited) {
+      count_op(op, visited);
+      if (callback) {
+        callback(op, visited);
+      }
+    }
+
+    // record the operation without calling the callback, for the paths
+    // that must not throw
+    void count_op(Op op, std::size_t visited) noexcept {
+      auto& op_stats = data.ops[static_cast<std::size_t>(op)];
+      ++op_stats.calls;
+      op_stats.visited += visited;
+      ++op_stats.histogram[OpStats::bucket_of(visited)];
+    }
+
+    void on_alloc(std::size_t n = 1) {
+      data.allocations += n;
+      on_transfer(static_cast<std::ptrdiff_t>(n));
+    }
+
+    void on_free(std::size_t n = 1) {
+      data.frees += n;
+      on_transfer(-static_cast<std::ptrdiff_t>(n));
+    }
+
+    // nodes handed over to or from another list
+    void on_transfer(std::ptrdiff_t n) {
+      data.live_nodes += static_cast<std::uint64_t>(n);
+      data.peak_nodes = std::max(data.peak_nodes, data.live_nodes);
+    }
+
+    void on_ref_update() { ++data.ref_updates; }
+
+    const StatsSnapshot& snapshot() const { return data; }
+
+    void set_callback(Callback cb) { callback = std::move(cb); }
+
+    //! Zero the counters, the live nodes are kept and become the peak.
+    void clear() {
+      const auto live = data.live_nodes;
+      data            = StatsSnapshot{};
+      data.live_nodes = data.peak_nodes = live;
+    }
+
+  private:
+    StatsSnapshot data;
+    Callback callback;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_STATS_HPP
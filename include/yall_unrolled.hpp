@@ -0,0 +1,624 @@
+//This file is part of Yall, a double linked list library.
+// Copyright (C) 2024 Mark Sweeney, marksweeneyster@gmail.com
+//
+// Yall is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef YALL_INCLUDE_YALL_UNROLLED_HPP
+#define YALL_INCLUDE_YALL_UNROLLED_HPP
+
+#include "yall_simd.hpp"
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace yall {
+
+  //! Unrolled doubly linked-list.
+  //!  Every node (chunk) stores up to ChunkSize values in a contiguous block,
+  //!  so a traversal takes one pointer hop per chunk instead of one per value
+  //!  and the link overhead is shared by all the values of a chunk.
+  //!  The API follows Yall, but only value types can be stored.
+  //!
+  //!  Inserting into a full chunk splits it in two, chunks are freed when
+  //!  they run empty (one empty chunk is kept around for reuse). Iterators are
+  //!  invalidated by any insert or erase in the same chunk.
+  //!
+  //!  For integer, float and double values the searches by value (find,
+  //!  rfind, count, remove_first, ...) compare a vector of values at a time
+  //!  within each chunk, see yall_simd.hpp.
+  //!
+  //!* \tparam T The type of the node data.
+  //!* \tparam ChunkSize The number of values per chunk.
+  template<typename T, std::size_t ChunkSize = 16>
+  class UnrolledYall final {
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "UnrolledYall stores values, use Yall for references");
+    static_assert(ChunkSize >= 2, "a chunk needs room for two values");
+
+    struct Chunk {
+      Chunk() {}// leave the storage uninitialized
+      ~Chunk() {
+        for (auto i = first; i < last; ++i) {
+          std::destroy_at(at(i));
+        }
+      }
+
+      Chunk(const Chunk&)            = delete;
+      Chunk& operator=(const Chunk&) = delete;
+
+      T* at(std::size_t i) {
+        return std::launder(reinterpret_cast<T*>(raw + i * sizeof(T)));
+      }
+      std::size_t size() const { return last - first; }
+
+      Chunk* prev = nullptr;
+      std::unique_ptr<Chunk> next;
+      // the values live in [first, last)
+      std::size_t first = 0;
+      std::size_t last  = 0;
+      alignas(T) std::byte raw[sizeof(T) * ChunkSize];
+    };
+    using ChunkPtr = std::unique_ptr<Chunk>;
+
+    // link a new chunk behind c (at the front for null), with an empty window
+    // starting at first
+    Chunk* insert_chunk_after(Chunk* c, std::size_t first) {
+      ChunkPtr chunk = spare ? std::move(spare) : std::make_unique<Chunk>();
+      auto* ptr      = chunk.get();
+      ptr->first     = first;
+      ptr->last      = first;
+
+      ChunkPtr& slot = c ? c->next : head;
+      chunk->prev    = c;
+      chunk->next    = std::move(slot);
+      if (chunk->next) {
+        chunk->next->prev = ptr;
+      } else {
+        tail = ptr;
+      }
+      slot = std::move(chunk);
+      return ptr;
+    }
+
+    // unlink an empty chunk, keeping it as the spare
+    void remove_chunk(Chunk* c) {
+      ChunkPtr& slot = c->prev ? c->prev->next : head;
+      ChunkPtr victim = std::move(slot);
+      slot            = std::move(victim->next);
+      if (slot) {
+        slot->prev = victim->prev;
+      } else {
+        tail = victim->prev;
+      }
+      victim->prev = nullptr;
+      if (!spare) {
+        spare = std::move(victim);
+      }
+    }
+
+    struct Position {
+      Chunk* chunk;
+      std::size_t idx;
+    };
+
+    // first value of the chunk, the end position for null
+    static Position start_of(Chunk* c) { return {c, c ? c->first : 0}; }
+
+    // construct a value in front of slot idx (first <= idx <= last) of c
+    template<typename... Args>
+    Position emplace_in(Chunk* c, std::size_t idx, Args&&... args) {
+      // fill up the previous chunk before shifting values around
+      if (idx == c->first && c->prev && c->prev->last < ChunkSize) {
+        auto* p = c->prev;
+        std::construct_at(p->at(p->last), std::forward<Args>(args)...);
+        ++length;
+        return {p, p->last++};
+      }
+      T value(std::forward<Args>(args)...);
+      if (c->size() == ChunkSize) {
+        // full, move the upper half to a new chunk
+        auto* n              = insert_chunk_after(c, 0);
+        const std::size_t mid = c->first + ChunkSize / 2;
+        for (auto i = mid; i < c->last; ++i) {
+          std::construct_at(n->at(n->last++), std::move(*c->at(i)));
+          std::destroy_at(c->at(i));
+        }
+        c->last = mid;
+        if (idx > mid) {
+          idx -= mid;
+          c = n;
+        }
+      }
+      ++length;
+      if (c->last < ChunkSize &&
+          (c->first == 0 || c->last - idx <= idx - c->first)) {
+        // shift [idx, last) up by one
+        if (idx == c->last) {
+          std::construct_at(c->at(idx), std::move(value));
+        } else {
+          std::construct_at(c->at(c->last), std::move(*c->at(c->last - 1)));
+          for (auto j = c->last - 1; j > idx; --j) {
+            *c->at(j) = std::move(*c->at(j - 1));
+          }
+          *c->at(idx) = std::move(value);
+        }
+        ++c->last;
+        return {c, idx};
+      }
+      // shift [first, idx) down by one
+      if (idx == c->first) {
+        std::construct_at(c->at(idx - 1), std::move(value));
+      } else {
+        std::construct_at(c->at(c->first - 1), std::move(*c->at(c->first)));
+        for (auto j = c->first; j + 1 < idx; ++j) {
+          *c->at(j) = std::move(*c->at(j + 1));
+        }
+        *c->at(idx - 1) = std::move(value);
+      }
+      --c->first;
+      return {c, idx - 1};
+    }
+
+    // remove the value at slot idx of c
+    // \return the position of the value that followed it
+    Position erase_at(Chunk* c, std::size_t idx) {
+      Position next{c, idx};
+      if (idx - c->first < c->last - 1 - idx) {
+        for (auto j = idx; j > c->first; --j) {
+          *c->at(j) = std::move(*c->at(j - 1));
+        }
+        std::destroy_at(c->at(c->first++));
+        next.idx = idx + 1;
+      } else {
+        for (auto j = idx; j + 1 < c->last; ++j) {
+          *c->at(j) = std::move(*c->at(j + 1));
+        }
+        std::destroy_at(c->at(--c->last));
+      }
+      --length;
+      if (c->size() == 0) {
+        auto* next_chunk = c->next.get();
+        remove_chunk(c);
+        return start_of(next_chunk);
+      }
+      if (next.idx == c->last) {
+        return start_of(c->next.get());
+      }
+      return next;
+    }
+
+    Position find_pos(const T& match_val) const {
+      for (auto* c = head.get(); c; c = c->next.get()) {
+        if constexpr (simd::Searchable<T>) {
+          const auto n = c->size();
+          const auto i = simd::find(c->at(c->first), n, match_val);
+          if (i < n) {
+            return {c, c->first + i};
+          }
+        } else {
+          for (auto i = c->first; i < c->last; ++i) {
+            if (*c->at(i) == match_val) {
+              return {c, i};
+            }
+          }
+        }
+      }
+      return {nullptr, 0};
+    }
+
+    Position rfind_pos(const T& match_val) const {
+      for (auto* c = tail; c; c = c->prev) {
+        if constexpr (simd::Searchable<T>) {
+          const auto n = c->size();
+          const auto i = simd::rfind(c->at(c->first), n, match_val);
+          if (i < n) {
+            return {c, c->first + i};
+          }
+        } else {
+          for (auto i = c->last; i-- > c->first;) {
+            if (*c->at(i) == match_val) {
+              return {c, i};
+            }
+          }
+        }
+      }
+      return {nullptr, 0};
+    }
+
+    // construct a value in front of pos, at the back for the end position
+    template<typename... Args>
+    Position emplace_pos(Position pos, Args&&... args) {
+      if (pos.chunk) {
+        return emplace_in(pos.chunk, pos.idx, std::forward<Args>(args)...);
+      }
+      emplace_back(std::forward<Args>(args)...);
+      return {tail, tail->last - 1};
+    }
+
+    static Position next_pos(Position pos) {
+      if (++pos.idx == pos.chunk->last) {
+        return start_of(pos.chunk->next.get());
+      }
+      return pos;
+    }
+
+  public:
+    static constexpr std::size_t chunk_size = ChunkSize;
+
+    UnrolledYall() = default;
+    ~UnrolledYall() { reset(); }
+
+    UnrolledYall(const UnrolledYall&)            = delete;
+    UnrolledYall& operator=(const UnrolledYall&) = delete;
+
+    UnrolledYall(UnrolledYall&& other) noexcept
+        : head(std::move(other.head)), tail(std::exchange(other.tail, nullptr)),
+          length(std::exchange(other.length, 0)) {}
+
+    UnrolledYall& operator=(UnrolledYall&& other) noexcept {
+      if (this != &other) {
+        reset();
+        head   = std::move(other.head);
+        tail   = std::exchange(other.tail, nullptr);
+        length = std::exchange(other.length, 0);
+      }
+      return *this;
+    }
+
+    //! Insert a new value at the front of the list.
+    //! \param data node value
+    void push_front(const T& data) { emplace_front(data); }
+    void push_front(T&& data) { emplace_front(std::move(data)); }
+
+    //! Construct a new value in place at the front of the list.
+    //! \return the new value
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+      if (!head || head->first == 0) {
+        insert_chunk_after(nullptr, ChunkSize);
+      }
+      auto* c = head.get();
+      std::construct_at(c->at(c->first - 1), std::forward<Args>(args)...);
+      ++length;
+      return *c->at(--c->first);
+    }
+
+    //! Insert a new value at the back of the list.
+    //! \param data node value
+    void push_back(const T& data) { emplace_back(data); }
+    void push_back(T&& data) { emplace_back(std::move(data)); }
+
+    //! Construct a new value in place at the back of the list.
+    //! \return the new value
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+      if (!tail || tail->last == ChunkSize) {
+        insert_chunk_after(tail, 0);
+      }
+      auto* c = tail;
+      std::construct_at(c->at(c->last), std::forward<Args>(args)...);
+      ++length;
+      return *c->at(c->last++);
+    }
+
+    //! Removes the first element in the list
+    void pop_front() {
+      if (head) {
+        erase_at(head.get(), head->first);
+      }
+    }
+
+    //! Removes the last element in the list.
+    void pop_back() {
+      if (tail) {
+        erase_at(tail, tail->last - 1);
+      }
+    }
+
+    //! Remove the first element, moving its value out.
+    //! \return the value that was at the front of the list, or none.
+    std::optional<T> pop_front_value() {
+      if (!head) {
+        return {};
+      }
+      std::optional<T> val(std::move(*head->at(head->first)));
+      pop_front();
+      return val;
+    }
+
+    //! Remove the last element, moving its value out.
+    //! \return the value that was at the back of the list, or none.
+    std::optional<T> pop_back_value() {
+      if (!tail) {
+        return {};
+      }
+      std::optional<T> val(std::move(*tail->at(tail->last - 1)));
+      pop_back();
+      return val;
+    }
+
+    //! \return a copy of the value at the front of the list, or none.
+    std::optional<T> front_val() const {
+      if (head) {
+        return *head->at(head->first);
+      }
+      return {};
+    }
+
+    //! \return a copy of the value at the back of the list, or none.
+    std::optional<T> back_val() const {
+      if (tail) {
+        return *tail->at(tail->last - 1);
+      }
+      return {};
+    }
+
+    //! Get the value at the front of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool front(T& ref) const {
+      if (head) {
+        ref = *head->at(head->first);
+        return true;
+      }
+      return false;
+    }
+
+    //! Get the value at the back of the list
+    //! \param ref Output
+    //! \return true if the list is not-empty and the reference has been assigned
+    bool back(T& ref) const {
+      if (tail) {
+        ref = *tail->at(tail->last - 1);
+        return true;
+      }
+      return false;
+    }
+
+    //! Start from the front of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_first(const T& match_val) {
+      if (auto pos = find_pos(match_val); pos.chunk) {
+        erase_at(pos.chunk, pos.idx);
+        return true;
+      }
+      return false;
+    }
+
+    //! Start from the back of the list, find the first match, and remove it.
+    //! \return true if the value was found and removed, otherwise false
+    bool remove_last(const T& match_val) {
+      if (auto pos = rfind_pos(match_val); pos.chunk) {
+        erase_at(pos.chunk, pos.idx);
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value before that
+    //! @return true if the new value has been inserted into the list
+    bool insert_before(const T& match_val, const T& new_val) {
+      if (auto pos = find_pos(match_val); pos.chunk) {
+        emplace_in(pos.chunk, pos.idx, new_val);
+        return true;
+      }
+      return false;
+    }
+
+    //! Look for first occurrence of the match value, insert new value after that
+    //! @return true if the new value has been inserted into the list
+    bool insert_after(const T& match_val, const T& new_val) {
+      if (auto pos = find_pos(match_val); pos.chunk) {
+        emplace_pos(next_pos(pos), new_val);
+        return true;
+      }
+      return false;
+    }
+
+    //! Insert a new value so that it ends up at position indx, or at the back
+    //! of the list if indx is past the end.
+    void insert_at(std::size_t indx, const T& new_val) {
+      emplace_at(indx, new_val);
+    }
+
+    //! Construct a new value in place at position indx, or at the back of
+    //! the list if indx is past the end. Whole chunks are skipped while
+    //! looking for the position.
+    template<typename... Args>
+    T& emplace_at(std::size_t indx, Args&&... args) {
+      auto* c = head.get();
+      while (c && indx >= c->size()) {
+        indx -= c->size();
+        c = c->next.get();
+      }
+      if (!c) {
+        return emplace_back(std::forward<Args>(args)...);
+      }
+      auto pos = emplace_in(c, c->first + indx, std::forward<Args>(args)...);
+      return *pos.chunk->at(pos.idx);
+    }
+
+    using PrinterCB = std::function<void(const T&)>;
+
+    //! Print the values in the list, front-to-back.
+    //!
+    //! \param printer_cb callback that will print node data to stdout
+    void print(PrinterCB printer_cb) const {
+      for (auto* c = head.get(); c; c = c->next.get()) {
+        for (auto i = c->first; i < c->last; ++i) {
+          printer_cb(*c->at(i));
+        }
+      }
+      std::cout << "|-\n";// list display "null-terminator"
+    }
+
+    //! Free all chunks (create an empty list), one chunk at a time.
+    void reset() noexcept {
+      while (head) {
+        head = std::move(head->next);
+      }
+      tail   = nullptr;
+      length = 0;
+      spare.reset();
+    }
+
+    //! \return whether the list is empty
+    bool empty() const { return length == 0; }
+
+    //! \return the number of elements
+    std::size_t size() const { return length; }
+
+    //! Bidirectional iterator, stepping past either end gives the end
+    //! iterator (the same for both directions).
+    template<bool IsConst>
+    struct BasicIterator {
+      // iterator traits
+      using iterator_category = std::bidirectional_iterator_tag;
+      using difference_type   = std::ptrdiff_t;
+      using value_type        = T;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      explicit BasicIterator() : pos{nullptr, 0} {}
+
+      template<bool OtherConst>
+        requires(IsConst && !OtherConst)
+      BasicIterator(const BasicIterator<OtherConst>& other) : pos(other.pos) {}
+
+      reference operator*() const { return *pos.chunk->at(pos.idx); }
+      pointer operator->() const { return pos.chunk->at(pos.idx); }
+
+      BasicIterator& operator++() {
+        pos = next_pos(pos);
+        return *this;
+      }
+
+      BasicIterator operator++(int) {
+        BasicIterator tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      BasicIterator& operator--() {
+        if (pos.idx == pos.chunk->first) {
+          auto* c = pos.chunk->prev;
+          pos     = {c, c ? c->last - 1 : 0};
+        } else {
+          --pos.idx;
+        }
+        return *this;
+      }
+
+      BasicIterator operator--(int) {
+        BasicIterator tmp = *this;
+        --(*this);
+        return tmp;
+      }
+
+      friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+        return a.pos.chunk == b.pos.chunk && a.pos.idx == b.pos.idx;
+      };
+      friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+        return !(a == b);
+      };
+
+    private:
+      friend class UnrolledYall;
+      friend struct BasicIterator<!IsConst>;
+
+      explicit BasicIterator(Position pos_) : pos(pos_) {}
+
+      Position pos;
+    };
+
+    using Iterator      = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    ConstIterator cbegin() const { return ConstIterator(start_of(head.get())); }
+    ConstIterator cend() const { return ConstIterator(); }
+    Iterator begin() { return Iterator(start_of(head.get())); }
+    Iterator end() { return Iterator(); }
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+
+    ConstIterator crbegin() const {
+      return tail ? ConstIterator(Position{tail, tail->last - 1})
+                  : ConstIterator();
+    }
+    ConstIterator crend() const { return ConstIterator(); }
+
+    //! Start from the front of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator find(const T& match_val) { return Iterator(find_pos(match_val)); }
+
+    //! \return the number of values equal to match_val
+    std::size_t count(const T& match_val) const {
+      std::size_t found = 0;
+      for (auto* c = head.get(); c; c = c->next.get()) {
+        if constexpr (simd::Searchable<T>) {
+          found += simd::count(c->at(c->first), c->size(), match_val);
+        } else {
+          for (auto i = c->first; i < c->last; ++i) {
+            found += *c->at(i) == match_val;
+          }
+        }
+      }
+      return found;
+    }
+
+    //! Start from the back of the list and find the first match.
+    //! \return an iterator to the match, or the end iterator
+    Iterator rfind(const T& match_val) {
+      return Iterator(rfind_pos(match_val));
+    }
+
+    //! Insert a new value in front of pos (at the back for the end iterator).
+    //! \return an iterator to the new value
+    Iterator insert(ConstIterator pos, const T& new_val) {
+      return emplace(pos, new_val);
+    }
+
+    Iterator insert(ConstIterator pos, T&& new_val) {
+      return emplace(pos, std::move(new_val));
+    }
+
+    //! Construct a new value in place in front of pos (at the back for the
+    //! end iterator).
+    //! \return an iterator to the new value
+    template<typename... Args>
+    Iterator emplace(ConstIterator pos, Args&&... args) {
+      return Iterator(emplace_pos(pos.pos, std::forward<Args>(args)...));
+    }
+
+    //! Remove the value at pos, which must be dereferenceable.
+    //! \return an iterator to the value that followed the removed one
+    Iterator erase(ConstIterator pos) {
+      return Iterator(erase_at(pos.pos.chunk, pos.pos.idx));
+    }
+
+  private:
+    ChunkPtr head;
+    Chunk* tail        = nullptr;
+    std::size_t length = 0;
+    ChunkPtr spare;
+  };
+}// namespace yall
+
+#endif//YALL_INCLUDE_YALL_UNROLLED_HPP
@@ -0,0 +1,120 @@
+#include "yall_concurrent.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentYallTest, Fifo) {
+  yall::ConcurrentYall<std::string> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_pop_front());
+  EXPECT_FALSE(queue.pop_front());
+
+  std::string two = "two";
+  queue.push_back("one");
+  queue.push_back(two);
+  queue.emplace_back(3, '3');
+  EXPECT_FALSE(queue.empty());
+
+  EXPECT_EQ(queue.try_pop_front(), "one");
+  EXPECT_EQ(queue.try_pop_front(), "two");
+  EXPECT_TRUE(queue.pop_front());
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_pop_front());
+
+  // whatever is left is freed with the queue
+  for (int i = 0; i < 1000; ++i) {
+    queue.emplace_back(100, 'x');
+  }
+}
+
+TEST(ConcurrentYallTest, MoveOnlyPayload) {
+  yall::ConcurrentYall<std::unique_ptr<int>> queue;
+  queue.push_back(std::make_unique<int>(1));
+  queue.emplace_back(new int(2));
+
+  auto one = queue.try_pop_front();
+  ASSERT_TRUE(one && *one);
+  EXPECT_EQ(**one, 1);
+  auto two = queue.try_pop_front();
+  ASSERT_TRUE(two && *two);
+  EXPECT_EQ(**two, 2);
+}
+
+namespace {
+  // a value whose move throws when it was made with fail set
+  struct Fragile {
+    int val;
+    bool fail;
+    Fragile(int val_, bool fail_) : val(val_), fail(fail_) {}
+    Fragile(Fragile&& other) : val(other.val), fail(other.fail) {
+      if (fail) {
+        throw std::runtime_error("no move");
+      }
+    }
+  };
+}// namespace
+
+TEST(ConcurrentYallTest, ThrowingMove) {
+  yall::ConcurrentYall<Fragile> queue;
+  queue.emplace_back(1, true);
+  queue.emplace_back(2, false);
+  EXPECT_THROW(queue.try_pop_front(), std::runtime_error);
+  auto two = queue.try_pop_front();
+  ASSERT_TRUE(two);
+  EXPECT_EQ(two->val, 2);
+  EXPECT_TRUE(queue.empty());
+}
+
+// Every value pushed is popped exactly once, and the values of one producer
+// come out in the order they were pushed.
+TEST(ConcurrentYallTest, ProducersConsumers) {
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int per_producer = 50'000;
+
+  yall::ConcurrentYall<std::pair<int, int>> queue;
+  std::atomic<int> popped{0};
+  std::vector<std::vector<int>> seen(producers * consumers);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, p] {
+      for (int i = 0; i < per_producer; ++i) {
+        queue.emplace_back(p, i);
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      while (popped.load() < producers * per_producer) {
+        if (auto val = queue.try_pop_front()) {
+          seen[c * producers + val->first].push_back(val->second);
+          ++popped;
+        }
+      }
+    });
+  }
+  for (auto& thread: threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(queue.empty());
+
+  std::vector<int> count(producers * per_producer, 0);
+  for (int c = 0; c < consumers; ++c) {
+    for (int p = 0; p < producers; ++p) {
+      const auto& vals = seen[c * producers + p];
+      EXPECT_TRUE(std::is_sorted(vals.begin(), vals.end()));
+      for (auto v: vals) {
+        ++count[p * per_producer + v];
+      }
+    }
+  }
+  EXPECT_TRUE(std::all_of(count.begin(), count.end(),
+                          [](int n) { return n == 1; }));
+}
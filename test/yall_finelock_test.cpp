@@ -0,0 +1,146 @@
+#include "yall_finelock.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(FineLockYallTest, Mutations) {
+  yall::FineLockYall<int> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_FALSE(list.front_val());
+  EXPECT_FALSE(list.back_val());
+  EXPECT_FALSE(list.pop_front());
+  EXPECT_FALSE(list.pop_back());
+  EXPECT_FALSE(list.remove_first(1));
+
+  list.push_back(2);
+  list.push_front(1);
+  list.emplace_back(4);
+  EXPECT_TRUE(list.insert_after(2, 3));
+  EXPECT_TRUE(list.insert_before(1, 0));
+  EXPECT_FALSE(list.insert_before(7, 0));
+  EXPECT_EQ(std::vector<int>(list.begin(), list.end()),
+            (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(list.size(), 5);
+  EXPECT_EQ(list.front_val(), 0);
+  EXPECT_EQ(list.back_val(), 4);
+  EXPECT_TRUE(list.contains(3));
+
+  EXPECT_TRUE(list.remove_first(2));
+  EXPECT_TRUE(list.pop_front());
+  EXPECT_TRUE(list.pop_back());
+  EXPECT_FALSE(list.contains(2));
+  EXPECT_EQ(std::vector<int>(list.begin(), list.end()),
+            (std::vector<int>{1, 3}));
+  EXPECT_EQ(list.size(), 2);
+}
+
+// An iterator keeps its node, it can carry on after the node is removed.
+TEST(FineLockYallTest, IteratorOutlivesRemoval) {
+  yall::FineLockYall<std::string> list;
+  list.push_back("a");
+  list.push_back("b");
+  list.push_back("c");
+
+  auto it = list.begin();
+  ++it;
+  EXPECT_TRUE(list.remove_first("b"));
+  EXPECT_EQ(*it, "b");
+  ++it;
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(++it, list.end());
+}
+
+// An iterator on the front pins every node drained behind it, letting it go
+// must not free them recursively.
+TEST(FineLockYallTest, DrainWhileIteratorPinned) {
+  // deep enough to overflow the stack if nodes were freed recursively
+  constexpr int sz = 1'000'000;
+  yall::FineLockYall<int> list;
+  for (int i = 0; i < sz; ++i) {
+    list.push_back(i);
+  }
+  auto it = list.begin();
+  std::thread drainer([&list] {
+    while (list.pop_front()) {
+    }
+  });
+  drainer.join();
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(*it, 0);
+  it = list.end();
+  EXPECT_EQ(list.begin(), list.end());
+}
+
+// Every thread edits around its own anchor while readers walk the list.
+// The anchors are never removed, so readers must always see them in order,
+// and at the end each region holds exactly what its thread left there.
+TEST(FineLockYallTest, DisjointEditsStress) {
+  constexpr int editors = 4;
+  constexpr int rounds  = 500;
+  constexpr int stride  = 1'000'000;
+
+  yall::FineLockYall<int> list;
+  for (int t = 0; t < editors; ++t) {
+    list.push_back(t * stride);
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> bad_reads{0};
+  std::vector<std::thread> threads;
+  for (int r = 0; r < 2; ++r) {
+    threads.emplace_back([&] {
+      while (!done.load()) {
+        int last_anchor = -1;
+        for (int val: list) {
+          if (val % stride == 0) {
+            if (val <= last_anchor) {
+              ++bad_reads;
+            }
+            last_anchor = val;
+          }
+        }
+      }
+    });
+  }
+  std::vector<std::thread> edit_threads;
+  for (int t = 0; t < editors; ++t) {
+    edit_threads.emplace_back([&list, t] {
+      const int anchor = t * stride;
+      for (int i = 1; i <= rounds; ++i) {
+        EXPECT_TRUE(list.insert_after(anchor, anchor + i));
+        EXPECT_TRUE(list.insert_before(anchor, -(anchor + i)));
+        if (i % 2 == 0) {
+          EXPECT_TRUE(list.remove_first(anchor + i - 1));
+          EXPECT_TRUE(list.remove_first(-(anchor + i)));
+        }
+      }
+    });
+  }
+  for (auto& thread: edit_threads) {
+    thread.join();
+  }
+  done = true;
+  for (auto& thread: threads) {
+    thread.join();
+  }
+  EXPECT_EQ(bad_reads.load(), 0);
+
+  // per region: the odd negatives in insertion order, the anchor, then the
+  // even values, latest first
+  std::vector<int> expected;
+  for (int t = 0; t < editors; ++t) {
+    const int anchor = t * stride;
+    for (int i = 1; i <= rounds; i += 2) {
+      expected.push_back(-(anchor + i));
+    }
+    expected.push_back(anchor);
+    for (int i = rounds; i >= 2; i -= 2) {
+      expected.push_back(anchor + i);
+    }
+  }
+  EXPECT_EQ(std::vector<int>(list.begin(), list.end()), expected);
+  EXPECT_EQ(list.size(), expected.size());
+}
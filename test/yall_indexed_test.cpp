@@ -0,0 +1,182 @@
+#include "yall.hpp"
+#include "yall_indexed.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  template<typename List>
+  std::vector<int> to_vector(const List& list) {
+    std::vector<int> vec(list.begin(), list.end());
+    std::vector<int> rev;
+    for (auto it = list.crbegin(); it != list.crend(); --it) {
+      rev.push_back(*it);
+    }
+    EXPECT_EQ(vec, std::vector<int>(rev.rbegin(), rev.rend()));
+    EXPECT_EQ(vec.size(), list.size());
+    return vec;
+  }
+
+  // throws for the value 13, as a failing index insert would
+  struct PickyHash {
+    std::size_t operator()(int val) const {
+      if (val == 13) {
+        throw std::runtime_error("no hash");
+      }
+      return std::hash<int>()(val);
+    }
+  };
+}// namespace
+
+TEST(IndexedYallTest, Duplicates) {
+  yall::IndexedYall<int> ilist;
+  EXPECT_TRUE(ilist.empty());
+  EXPECT_FALSE(ilist.remove_first(1));
+  EXPECT_FALSE(ilist.insert_after(1, 2));
+  EXPECT_EQ(ilist.find(1), ilist.end());
+
+  for (int i: {1, 2, 1, 3, 1}) {
+    ilist.push_back(i);
+  }
+  EXPECT_EQ(ilist.distinct(), 3);
+  EXPECT_EQ(ilist.count_of(1), 3);
+  EXPECT_EQ(std::distance(ilist.begin(), ilist.find(1)), 0);
+  EXPECT_EQ(std::distance(ilist.begin(), ilist.rfind(1)), 4);
+
+  EXPECT_TRUE(ilist.insert_after(1, 4));
+  EXPECT_TRUE(ilist.insert_before(3, 1));
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{1, 4, 2, 1, 1, 3, 1}));
+
+  EXPECT_TRUE(ilist.remove_last(1));
+  EXPECT_TRUE(ilist.remove_first(1));
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{4, 2, 1, 1, 3}));
+  EXPECT_EQ(std::distance(ilist.begin(), ilist.find(1)), 2);
+  EXPECT_EQ(std::distance(ilist.begin(), ilist.rfind(1)), 3);
+
+  EXPECT_EQ(ilist.pop_front_value(), 4);
+  EXPECT_EQ(ilist.pop_back_value(), 3);
+  EXPECT_FALSE(ilist.contains(3));
+  EXPECT_EQ(ilist.distinct(), 2);
+
+  auto it = ilist.erase(ilist.find(1));
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{2, 1}));
+}
+
+TEST(IndexedYallTest, ThrowingIndex) {
+  yall::IndexedYall<int, PickyHash> ilist;
+  ilist.push_back(1);
+  ilist.push_back(2);
+  EXPECT_THROW(ilist.push_front(13), std::runtime_error);
+  EXPECT_THROW(ilist.insert_after(1, 13), std::runtime_error);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{1, 2}));
+  EXPECT_EQ(ilist.distinct(), 2);
+  EXPECT_TRUE(ilist.remove_first(1));
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{2}));
+}
+
+TEST(IndexedYallTest, Strings) {
+  yall::IndexedYall<std::string> slist;
+  slist.emplace_back(3, 'b');
+  slist.push_front("a");
+  slist.emplace_at(1, "c");
+  EXPECT_EQ(std::vector<std::string>(slist.begin(), slist.end()),
+            (std::vector<std::string>{"a", "c", "bbb"}));
+  EXPECT_TRUE(slist.remove_first("c"));
+  EXPECT_EQ(slist.front_val(), "a");
+  EXPECT_EQ(slist.back_val(), "bbb");
+}
+
+// Inserting again and again at the same spot uses up the label gaps.
+TEST(IndexedYallTest, Relabel) {
+  yall::IndexedYall<int> ilist;
+  std::vector<int> expected{0, 1};
+  ilist.push_back(0);
+  ilist.push_back(1);
+  for (int i = 0; i < 5000; ++i) {
+    const int val = i % 3 + 2;
+    ilist.insert_before(1, val);
+    expected.insert(expected.end() - 1, val);
+    ilist.insert_after(0, val);
+    expected.insert(expected.begin() + 1, val);
+  }
+  EXPECT_EQ(to_vector(ilist), expected);
+  for (int val: {2, 3, 4}) {
+    // the chains must be in list order for this to keep working
+    for (int n = 0; n < 100; ++n) {
+      ilist.remove_last(val);
+      expected.erase(std::find(expected.rbegin(), expected.rend(), val).base() -
+                     1);
+      ilist.remove_first(val);
+      expected.erase(std::find(expected.begin(), expected.end(), val));
+    }
+  }
+  EXPECT_EQ(to_vector(ilist), expected);
+}
+
+// Random operations on a few distinct values, against the unindexed list.
+TEST(IndexedYallTest, MatchesYall) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> val_dist(0, 9);
+  std::uniform_int_distribution<int> op_dist(0, 10);
+
+  yall::IndexedYall<int> ilist;
+  yall::Yall<int, std::allocator<int>, yall::UniqueOwnership> ref;
+  for (int step = 0; step < 20'000; ++step) {
+    const int val = val_dist(gen);
+    const int other = val_dist(gen);
+    switch (op_dist(gen)) {
+      case 0:
+        ilist.push_front(val);
+        ref.push_front(val);
+        break;
+      case 1:
+      case 2:
+        ilist.push_back(val);
+        ref.push_back(val);
+        break;
+      case 3:
+        ilist.pop_front();
+        ref.pop_front();
+        break;
+      case 4:
+        EXPECT_EQ(ilist.pop_back_value(), ref.pop_back_value());
+        break;
+      case 5:
+        EXPECT_EQ(ilist.remove_first(val), ref.remove_first(val));
+        break;
+      case 6:
+        EXPECT_EQ(ilist.remove_last(val), ref.remove_last(val));
+        break;
+      case 7:
+        EXPECT_EQ(ilist.insert_before(val, other),
+                  ref.insert_before(val, other));
+        break;
+      case 8:
+        EXPECT_EQ(ilist.insert_after(val, other), ref.insert_after(val, other));
+        break;
+      case 9: {
+        const auto indx = ref.empty() ? 0 : gen() % (ref.size() + 1);
+        ilist.insert_at(indx, val);
+        ref.insert_at(indx, val);
+        break;
+      }
+      default:
+        EXPECT_EQ(ilist.pop_front_value(), ref.pop_front_value());
+        break;
+    }
+    if (step % 500 == 0) {
+      const auto vec = to_vector(ilist);
+      ASSERT_EQ(vec, std::vector<int>(ref.begin(), ref.end()));
+      for (int v = 0; v < 10; ++v) {
+        EXPECT_EQ(ilist.count_of(v),
+                  static_cast<size_t>(std::count(vec.begin(), vec.end(), v)));
+      }
+    }
+  }
+  EXPECT_EQ(to_vector(ilist), std::vector<int>(ref.begin(), ref.end()));
+}
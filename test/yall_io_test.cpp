@@ -0,0 +1,204 @@
+#include "yall.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  struct Point {
+    double x;
+    std::int32_t id;
+  };
+
+  // bigger than the block buffer of save and load
+  struct Big {
+    std::int32_t id;
+    char payload[20000];
+  };
+
+  struct Named {
+    std::string name;
+    int id;
+    bool operator==(const Named&) const = default;
+  };
+
+  // length prefixed name, then the id
+  struct NamedCodec {
+    void write(std::ostream& os, const Named& val) {
+      const auto len = static_cast<std::uint32_t>(val.name.size());
+      os.write(reinterpret_cast<const char*>(&len), sizeof(len));
+      os.write(val.name.data(), len);
+      os.write(reinterpret_cast<const char*>(&val.id), sizeof(val.id));
+    }
+    std::optional<Named> read(std::istream& is) {
+      std::uint32_t len = 0;
+      if (!is.read(reinterpret_cast<char*>(&len), sizeof(len)) || len > 1024) {
+        return {};
+      }
+      Named val{std::string(len, '\0'), 0};
+      is.read(val.name.data(), len);
+      is.read(reinterpret_cast<char*>(&val.id), sizeof(val.id));
+      if (!is) {
+        return {};
+      }
+      return val;
+    }
+  };
+
+  template<typename List>
+  auto to_vector(List& list) {
+    return std::vector<std::decay_t<decltype(*list.begin())>>(list.begin(),
+                                                              list.end());
+  }
+}// namespace
+
+template<typename Ownership>
+class IoTest : public ::testing::Test {};
+
+using Ownerships =
+        ::testing::Types<yall::SharedOwnership, yall::UniqueOwnership>;
+TYPED_TEST_SUITE(IoTest, Ownerships);
+
+TYPED_TEST(IoTest, RawRoundTrip) {
+  using List = yall::Yall<double, std::allocator<double>, TypeParam>;
+  // several blocks worth, and an empty list
+  for (int n: {0, 1, 5000}) {
+    List list;
+    for (int i = 0; i < n; ++i) {
+      list.push_back(i * 0.5);
+    }
+    std::stringstream buf;
+    ASSERT_TRUE(list.save(buf));
+    EXPECT_EQ(buf.str().size(), sizeof(yall::io::Header) + n * sizeof(double));
+
+    List loaded;
+    loaded.push_back(-1);
+    ASSERT_TRUE(loaded.load(buf));
+    EXPECT_EQ(to_vector(loaded), to_vector(list));
+    EXPECT_EQ(loaded.size(), list.size());
+  }
+}
+
+TYPED_TEST(IoTest, RawStruct) {
+  yall::Yall<Point, std::allocator<Point>, TypeParam> list;
+  list.push_back({1.5, 1});
+  list.push_back({-2.0, 2});
+  std::stringstream buf;
+  ASSERT_TRUE(list.save(buf));
+
+  yall::Yall<Point, std::allocator<Point>, TypeParam> loaded;
+  ASSERT_TRUE(loaded.load(buf));
+  ASSERT_EQ(loaded.size(), 2);
+  EXPECT_EQ(loaded.back_val()->x, -2.0);
+  EXPECT_EQ(loaded.back_val()->id, 2);
+}
+
+TYPED_TEST(IoTest, RawValueBiggerThanBlock) {
+  static_assert(sizeof(Big) > yall::io::block_bytes);
+  using List = yall::Yall<Big, std::allocator<Big>, TypeParam>;
+  List list;
+  for (int i = 0; i < 3; ++i) {
+    auto& big = list.emplace_back();
+    big.id    = i;
+    std::fill(std::begin(big.payload), std::end(big.payload),
+              static_cast<char>('a' + i));
+  }
+  std::stringstream buf;
+  ASSERT_TRUE(list.save(buf));
+  EXPECT_EQ(buf.str().size(), sizeof(yall::io::Header) + 3 * sizeof(Big));
+
+  List loaded;
+  ASSERT_TRUE(loaded.load(buf));
+  ASSERT_EQ(loaded.size(), 3);
+  int i = 0;
+  for (const auto& big: loaded) {
+    EXPECT_EQ(big.id, i);
+    EXPECT_EQ(big.payload[0], 'a' + i);
+    EXPECT_EQ(big.payload[sizeof(big.payload) - 1], 'a' + i);
+    ++i;
+  }
+
+  // a stream ending within a value is rejected
+  std::stringstream again;
+  ASSERT_TRUE(list.save(again));
+  std::stringstream cut(again.str().substr(0, again.str().size() - 1));
+  EXPECT_FALSE(loaded.load(cut));
+  EXPECT_EQ(loaded.size(), 3);
+}
+
+TYPED_TEST(IoTest, CodecRoundTrip) {
+  using List = yall::Yall<Named, std::allocator<Named>, TypeParam>;
+  List list;
+  list.push_back({"foo", 42});
+  list.push_back({"", 7});
+  list.push_back({std::string(300, 'x'), 3});
+
+  std::stringstream buf;
+  ASSERT_TRUE(list.save(buf, NamedCodec{}));
+  List loaded;
+  ASSERT_TRUE(loaded.load(buf, NamedCodec{}));
+  EXPECT_EQ(to_vector(loaded), to_vector(list));
+}
+
+// A bad stream leaves the list alone.
+TEST(IoTest, Rejects) {
+  yall::Yall<double> list;
+  list.push_back(1.0);
+  list.push_back(2.0);
+  std::stringstream saved;
+  ASSERT_TRUE(list.save(saved));
+  const auto bytes = saved.str();
+
+  yall::Yall<double> target;
+  target.push_back(9.0);
+  auto rejects = [&target](const std::string& data) {
+    std::stringstream buf(data);
+    EXPECT_FALSE(target.load(buf));
+    EXPECT_EQ(to_vector(target), std::vector<double>{9.0});
+  };
+  rejects("");
+  rejects("nonsense, not a list at all");
+  rejects(bytes.substr(0, bytes.size() - 1));// truncated
+
+  std::string other_version = bytes;
+  other_version[4]          = 99;
+  rejects(other_version);
+
+  // the right header for another value type
+  yall::Yall<float> floats;
+  floats.push_back(1.0f);
+  std::stringstream float_buf;
+  ASSERT_TRUE(floats.save(float_buf));
+  rejects(float_buf.str());
+
+  // a codec stream isn't raw data
+  yall::Yall<Named> named;
+  named.push_back({"a", 1});
+  std::stringstream named_buf;
+  ASSERT_TRUE(named.save(named_buf, NamedCodec{}));
+  rejects(named_buf.str());
+
+  yall::Yall<Named> named_target;
+  std::stringstream raw_buf(bytes);
+  EXPECT_FALSE(named_target.load(raw_buf, NamedCodec{}));
+}
+
+// Loading into a list on a NodePool keeps using the pool.
+TEST(IoTest, PoolLoad) {
+  yall::Yall<int> list;
+  for (int i = 0; i < 3000; ++i) {
+    list.push_back(i);
+  }
+  std::stringstream buf;
+  ASSERT_TRUE(list.save(buf));
+
+  yall::NodePool pool;
+  yall::pmr::Yall<int, yall::UniqueOwnership> loaded(&pool);
+  ASSERT_TRUE(loaded.load(buf));
+  EXPECT_EQ(to_vector(loaded), to_vector(list));
+  EXPECT_EQ(pool.live_blocks(), 3000);
+}
@@ -0,0 +1,155 @@
+#include "yall_lru.hpp"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  template<typename Cache>
+  auto keys(const Cache& cache) {
+    std::vector<std::decay_t<decltype(cache.begin()->key)>> vec;
+    for (const auto& entry: cache) {
+      vec.push_back(entry.key);
+    }
+    EXPECT_EQ(vec.size(), cache.size());
+    return vec;
+  }
+
+  // throws when copied while armed
+  struct Touchy {
+    explicit Touchy(int val_) : val(val_) {}
+    Touchy(const Touchy& other) : val(other.val) { check(); }
+    Touchy& operator=(const Touchy& other) {
+      check();
+      val = other.val;
+      return *this;
+    }
+
+    static void check() {
+      if (armed) {
+        throw std::runtime_error("copy");
+      }
+    }
+
+    int val;
+    static inline bool armed = false;
+  };
+}// namespace
+
+TEST(LruTest, Operations) {
+  yall::LruCache<int, std::string> cache(3);
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(cache.capacity(), 3);
+  EXPECT_EQ(cache.get(1), nullptr);
+
+  EXPECT_TRUE(cache.put(1, "one"));
+  EXPECT_TRUE(cache.put(2, "two"));
+  EXPECT_TRUE(cache.put(3, "three"));
+  EXPECT_EQ(keys(cache), (std::vector<int>{3, 2, 1}));
+
+  ASSERT_NE(cache.get(1), nullptr);
+  EXPECT_EQ(*cache.get(1), "one");
+  EXPECT_EQ(keys(cache), (std::vector<int>{1, 3, 2}));
+
+  EXPECT_FALSE(cache.put(3, "THREE"));
+  EXPECT_EQ(*cache.peek(3), "THREE");
+  EXPECT_EQ(keys(cache), (std::vector<int>{3, 1, 2}));
+
+  EXPECT_TRUE(cache.touch(2));
+  EXPECT_FALSE(cache.touch(4));
+  EXPECT_EQ(keys(cache), (std::vector<int>{2, 3, 1}));
+
+  // peek and contains leave the order alone
+  EXPECT_EQ(*cache.peek(1), "one");
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_EQ(cache.peek(4), nullptr);
+  EXPECT_EQ(keys(cache), (std::vector<int>{2, 3, 1}));
+
+  EXPECT_TRUE(cache.erase(3));
+  EXPECT_FALSE(cache.erase(3));
+  EXPECT_FALSE(cache.contains(3));
+  EXPECT_EQ(keys(cache), (std::vector<int>{2, 1}));
+
+  cache.clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(cache.get(2), nullptr);
+}
+
+// A full cache drops the least recently used key, reusing its node.
+TEST(LruTest, Eviction) {
+  yall::LruCache<std::string, int> cache(3);
+  for (int i = 0; i < 3; ++i) {
+    cache.put(std::to_string(i), i);
+  }
+  const int* zero = cache.peek("0");
+  cache.get("0");
+  EXPECT_TRUE(cache.put("3", 3));
+  EXPECT_FALSE(cache.contains("1"));
+  EXPECT_EQ(keys(cache), (std::vector<std::string>{"3", "0", "2"}));
+  EXPECT_EQ(cache.peek("0"), zero);
+
+  const int* two = cache.peek("2");
+  EXPECT_TRUE(cache.put("4", 4));
+  EXPECT_EQ(cache.peek("4"), two);
+  EXPECT_EQ(*cache.peek("4"), 4);
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.stats().evictions, 2);
+
+  cache.set_capacity(1);
+  EXPECT_EQ(keys(cache), (std::vector<std::string>{"4"}));
+  EXPECT_EQ(cache.stats().evictions, 4);
+
+  yall::LruCache<int, int> none(0);
+  EXPECT_FALSE(none.put(1, 1));
+  EXPECT_TRUE(none.empty());
+}
+
+TEST(LruTest, Stats) {
+  yall::LruCache<int, int> cache(2);
+  cache.put(1, 10);
+  cache.get(1);
+  cache.get(1);
+  cache.get(2);
+  cache.touch(1);
+  cache.peek(2);
+  EXPECT_EQ(cache.stats().hits, 2);
+  EXPECT_EQ(cache.stats().misses, 1);
+  EXPECT_EQ(cache.stats().evictions, 0);
+
+  cache.clear_stats();
+  EXPECT_EQ(cache.stats().hits, 0);
+  EXPECT_EQ(cache.stats().misses, 0);
+}
+
+TEST(LruTest, MoveOnlyValues) {
+  yall::LruCache<int, std::unique_ptr<int>> cache(2);
+  cache.put(1, std::make_unique<int>(1));
+  cache.put(2, std::make_unique<int>(2));
+  cache.put(3, std::make_unique<int>(3));
+  EXPECT_EQ(cache.get(1), nullptr);
+  EXPECT_EQ(**cache.get(2), 2);
+
+  auto moved = std::move(cache);
+  EXPECT_EQ(keys(moved), (std::vector<int>{2, 3}));
+  EXPECT_EQ(**moved.get(3), 3);
+}
+
+// A value assignment throwing while a node is reused drops the evicted
+// entry only.
+TEST(LruTest, ThrowingEviction) {
+  yall::LruCache<int, Touchy> cache(2);
+  cache.put(1, Touchy(1));
+  cache.put(2, Touchy(2));
+  Touchy::armed = true;
+  EXPECT_THROW(cache.put(3, Touchy(3)), std::runtime_error);
+  Touchy::armed = false;
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.stats().evictions, 1);
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_FALSE(cache.contains(3));
+  EXPECT_EQ(cache.get(2)->val, 2);
+  EXPECT_TRUE(cache.put(3, Touchy(3)));
+  EXPECT_EQ(keys(cache), (std::vector<int>{3, 2}));
+}
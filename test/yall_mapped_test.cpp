@@ -0,0 +1,249 @@
+#include "yall_mapped.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  struct Point {
+    double x;
+    std::int32_t id;
+    bool operator==(const Point&) const = default;
+  };
+
+  // bigger than a node's share of any early mapping
+  struct Blob {
+    std::int32_t id;
+    char bytes[200'000];
+  };
+
+  template<typename List>
+  auto to_vector(const List& list) {
+    return std::vector<std::decay_t<decltype(*list.begin())>>(list.begin(),
+                                                              list.end());
+  }
+}// namespace
+
+class MappedTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    path             = (std::filesystem::temp_directory_path() /
+            (std::string("yall_mapped_") + info->name() + ".bin"))
+                   .string();
+    std::filesystem::remove(path);
+  }
+  void TearDown() override { std::filesystem::remove(path); }
+
+  std::string path;
+};
+
+TEST_F(MappedTest, Operations) {
+  yall::MappedYall<int> list;
+  EXPECT_FALSE(list.is_open());
+  EXPECT_TRUE(list.empty());
+  ASSERT_TRUE(list.open(path));
+  EXPECT_TRUE(list.empty());
+
+  list.push_back(2);
+  list.push_back(4);
+  list.push_front(1);
+  EXPECT_TRUE(list.insert_before(4, 3));
+  EXPECT_TRUE(list.insert_after(4, 6));
+  list.insert_at(4, 5);
+  list.insert_at(100, 7);
+  EXPECT_FALSE(list.insert_before(42, 0));
+  EXPECT_EQ(to_vector(list), (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(list.size(), 7);
+
+  EXPECT_TRUE(list.remove_first(4));
+  EXPECT_FALSE(list.remove_last(42));
+  EXPECT_EQ(list.pop_front_value(), 1);
+  EXPECT_EQ(list.pop_back_value(), 7);
+  EXPECT_EQ(to_vector(list), (std::vector<int>{2, 3, 5, 6}));
+
+  int val = 0;
+  EXPECT_TRUE(list.front(val));
+  EXPECT_EQ(val, 2);
+  EXPECT_TRUE(list.back(val));
+  EXPECT_EQ(val, 6);
+
+  // backwards
+  std::vector<int> reversed;
+  for (auto it = list.crbegin(); it != list.crend(); --it) {
+    reversed.push_back(*it);
+  }
+  EXPECT_EQ(reversed, (std::vector<int>{6, 5, 3, 2}));
+
+  // position based edits
+  auto it = list.find(3);
+  *it     = 30;
+  it      = list.erase(it);
+  EXPECT_EQ(*it, 5);
+  list.insert(it, 4);
+  EXPECT_EQ(list.find(42), list.end());
+  EXPECT_EQ(to_vector(list), (std::vector<int>{2, 4, 5, 6}));
+
+  list.reset();
+  EXPECT_TRUE(list.empty());
+  EXPECT_FALSE(list.pop_front_value());
+  list.pop_back();
+  list.push_back(8);
+  EXPECT_EQ(to_vector(list), std::vector<int>{8});
+}
+
+// What is in the file is the list next time it is opened.
+TEST_F(MappedTest, Reopen) {
+  {
+    yall::MappedYall<Point> list;
+    ASSERT_TRUE(list.open(path));
+    for (int i = 0; i < 10; ++i) {
+      list.push_back({i * 0.5, i});
+    }
+    list.pop_front();
+    list.remove_first({2.0, 4});
+    EXPECT_TRUE(list.sync());
+  }
+  yall::MappedYall<Point> list;
+  ASSERT_TRUE(list.open(path));
+  ASSERT_EQ(list.size(), 8);
+  EXPECT_EQ(list.front_val(), (Point{0.5, 1}));
+  EXPECT_EQ(list.back_val(), (Point{4.5, 9}));
+  EXPECT_EQ(list.find({2.0, 4}), list.end());
+
+  // removed nodes are reused
+  const auto file_size = std::filesystem::file_size(path);
+  list.push_front({0.0, 0});
+  list.push_front({-1.0, -1});
+  EXPECT_EQ(list.size(), 10);
+  EXPECT_EQ(std::filesystem::file_size(path), file_size);
+  EXPECT_TRUE(list.flush());
+
+  list.close();
+  EXPECT_FALSE(list.is_open());
+  EXPECT_EQ(list.size(), 0);
+  ASSERT_TRUE(list.open(path));
+  EXPECT_EQ(list.front_val(), (Point{-1.0, -1}));
+}
+
+// Growing remaps the file, iterators hold on.
+TEST_F(MappedTest, Growth) {
+  yall::MappedYall<std::int64_t> list;
+  ASSERT_TRUE(list.open(path));
+  list.push_back(-1);
+  auto first = list.begin();
+  const auto initial_size = std::filesystem::file_size(path);
+  constexpr int n         = 100'000;
+  for (int i = 0; i < n; ++i) {
+    list.push_back(i);
+  }
+  EXPECT_GT(std::filesystem::file_size(path), initial_size);
+  EXPECT_EQ(*first, -1);
+  EXPECT_EQ(*++first, 0);
+
+  yall::MappedYall<std::int64_t> moved(std::move(list));
+  EXPECT_FALSE(list.is_open());
+  moved.close();
+  ASSERT_TRUE(moved.open(path));
+  ASSERT_EQ(moved.size(), n + 1);
+  std::int64_t expected = -1;
+  for (auto val: moved) {
+    ASSERT_EQ(val, expected++);
+  }
+}
+
+// A node bigger than the doubled file still gets room.
+TEST_F(MappedTest, HugeValues) {
+  auto blob = std::make_unique<Blob>();
+  yall::MappedYall<Blob> list;
+  ASSERT_TRUE(list.open(path));
+  for (int i = 0; i < 3; ++i) {
+    blob->id = i;
+    std::fill(std::begin(blob->bytes), std::end(blob->bytes),
+              static_cast<char>('a' + i));
+    list.push_back(*blob);
+  }
+  ASSERT_EQ(list.size(), 3);
+  int i = 0;
+  for (const auto& val: list) {
+    EXPECT_EQ(val.id, i);
+    EXPECT_EQ(val.bytes[sizeof(val.bytes) - 1], 'a' + i);
+    ++i;
+  }
+}
+
+// Values taken from the list itself survive the remap when it grows.
+TEST_F(MappedTest, PushOwnValue) {
+  struct Chunk {
+    std::int64_t vals[64];
+  };
+  yall::MappedYall<Chunk> list;
+  ASSERT_TRUE(list.open(path));
+  Chunk first{};
+  for (int i = 0; i < 64; ++i) {
+    first.vals[i] = i;
+  }
+  list.push_back(first);
+  const auto initial_size = std::filesystem::file_size(path);
+  // well past the initial 64 KiB
+  for (int i = 0; i < 1000; ++i) {
+    list.push_back(*list.begin());
+    list.push_front(*list.crbegin());
+  }
+  EXPECT_GT(std::filesystem::file_size(path), initial_size);
+  ASSERT_EQ(list.size(), 2001);
+  for (const auto& chunk: list) {
+    ASSERT_EQ(chunk.vals[0], 0);
+    ASSERT_EQ(chunk.vals[63], 63);
+  }
+}
+
+TEST_F(MappedTest, Rejects) {
+  {
+    yall::MappedYall<double> list;
+    ASSERT_TRUE(list.open(path));
+    list.push_back(1.0);
+  }
+  // another value type
+  yall::MappedYall<char> chars;
+  EXPECT_FALSE(chars.open(path));
+  EXPECT_FALSE(chars.is_open());
+
+  // not a list
+  {
+    std::ofstream out(path, std::ios::trunc);
+    out << "nonsense, not a list at all, and longer than a header too......";
+  }
+  yall::MappedYall<double> list;
+  EXPECT_FALSE(list.open(path));
+
+  EXPECT_FALSE(list.open("/no/such/dir/yall.bin"));
+  EXPECT_FALSE(list.flush());
+  EXPECT_FALSE(list.sync());
+}
+
+TEST_F(MappedTest, Closed) {
+  yall::MappedYall<int> list;
+  EXPECT_THROW(list.push_front(1), std::logic_error);
+  EXPECT_THROW(list.emplace_back(2), std::logic_error);
+  EXPECT_THROW(list.insert_at(0, 3), std::logic_error);
+  EXPECT_THROW(list.insert(list.cend(), 4), std::logic_error);
+  EXPECT_FALSE(list.insert_after(1, 5));
+  list.pop_front();
+  EXPECT_FALSE(list.remove_first(1));
+  EXPECT_TRUE(list.empty());
+
+  ASSERT_TRUE(list.open(path));
+  list.push_back(1);
+  list.close();
+  EXPECT_THROW(list.push_back(2), std::logic_error);
+  EXPECT_EQ(list.size(), 0u);
+}
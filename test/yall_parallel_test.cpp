@@ -0,0 +1,169 @@
+#include "yall.hpp"
+#include "yall_parallel.hpp"
+#include "yall_unrolled.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  // long enough to be split over several threads
+  constexpr int length = 100'003;
+
+  template<typename List>
+  List make_list(int n) {
+    List list;
+    for (int i = 0; i < n; ++i) {
+      list.push_back(i);
+    }
+    return list;
+  }
+}// namespace
+
+template<typename List>
+class ParallelTest : public ::testing::Test {};
+
+using ParallelLists =
+        ::testing::Types<yall::Yall<int>, yall::UnrolledYall<int>>;
+TYPED_TEST_SUITE(ParallelTest, ParallelLists);
+
+// The segments cover the list in order, without gaps or overlaps.
+TYPED_TEST(ParallelTest, Segments) {
+  for (int n: {0, 1, 5000, length}) {
+    auto list = make_list<TypeParam>(n);
+    for (unsigned parts: {1u, 3u, 8u}) {
+      yall::Segments segs(list, parts);
+      ASSERT_GE(segs.size(), 1);
+      EXPECT_LE(segs.size(), parts);
+      EXPECT_TRUE(segs.begin(0) == list.begin());
+      EXPECT_TRUE(segs.end(segs.size() - 1) == list.end());
+
+      std::vector<int> walked;
+      for (std::size_t i = 0; i < segs.size(); ++i) {
+        for (auto it = segs.begin(i); it != segs.end(i); ++it) {
+          walked.push_back(*it);
+        }
+      }
+      EXPECT_EQ(walked, std::vector<int>(list.begin(), list.end()));
+    }
+  }
+}
+
+TYPED_TEST(ParallelTest, ForEachCountReduce) {
+  for (int n: {0, 1, length}) {
+    auto list = make_list<TypeParam>(n);
+    for (unsigned threads: {1u, 3u, 8u}) {
+      std::atomic<long long> sum{0};
+      yall::par_for_each(list, [&sum](int val) { sum += val; }, threads);
+      const long long expected = static_cast<long long>(n) * (n - 1) / 2;
+      EXPECT_EQ(sum.load(), expected);
+
+      EXPECT_EQ(yall::par_reduce(list, 0LL, std::plus<>{}, std::identity{},
+                                 threads),
+                expected);
+      EXPECT_EQ(yall::par_count_if(
+                        list, [](int val) { return val % 3 == 0; }, threads),
+                (n + 2) / 3);
+    }
+  }
+}
+
+// The partial results are combined in list order, so op needn't commute.
+TYPED_TEST(ParallelTest, ReduceKeepsOrder) {
+  auto list = make_list<TypeParam>(length);
+  auto digit = [](int val) { return std::string(1, char('0' + val % 10)); };
+
+  std::string expected;
+  for (int val: list) {
+    expected += digit(val);
+  }
+  auto concat = [](std::string a, const std::string& b) {
+    return std::move(a) + b;
+  };
+  EXPECT_EQ(yall::par_reduce(list, std::string("x"), concat, digit, 8),
+            "x" + expected);
+}
+
+// The match nearest the front wins, whichever thread finds one first.
+TYPED_TEST(ParallelTest, FindIf) {
+  auto list = make_list<TypeParam>(length);
+  for (unsigned threads: {1u, 3u, 8u}) {
+    auto it = yall::par_find_if(
+            list, [](int val) { return val % 40'000 == 39'999; }, threads);
+    ASSERT_TRUE(it != list.end());
+    EXPECT_EQ(*it, 39'999);
+
+    it = yall::par_find_if(list, [](int val) { return val == length - 1; },
+                           threads);
+    ASSERT_TRUE(it != list.end());
+    EXPECT_EQ(*it, length - 1);
+
+    it = yall::par_find_if(list, [](int val) { return val < 0; }, threads);
+    EXPECT_TRUE(it == list.end());
+  }
+
+  TypeParam empty;
+  EXPECT_TRUE(yall::par_find_if(empty, [](int) { return true; }) ==
+              empty.end());
+}
+
+// Segments can be built once and shared by several passes.
+TEST(ParallelTest, ReuseSegments) {
+  auto list = make_list<yall::Yall<int>>(length);
+  yall::Segments segs(list, 4);
+
+  EXPECT_EQ(yall::par_count_if(segs, [](int val) { return val >= 0; }),
+            length);
+  EXPECT_EQ(yall::par_reduce(segs, 0, [](int a, int b) { return a ^ b; }),
+            yall::par_reduce(list, 0, [](int a, int b) { return a ^ b; }));
+  EXPECT_EQ(*yall::par_find_if(segs, [](int val) { return val == 7; }), 7);
+}
+
+TEST(ParallelTest, ExceptionPropagates) {
+  auto list = make_list<yall::Yall<int>>(length);
+  EXPECT_THROW(yall::par_for_each(
+                       list,
+                       [](int val) {
+                         if (val == length - 1) {
+                           throw std::runtime_error("last");
+                         }
+                       },
+                       4),
+               std::runtime_error);
+}
+
+// The worker pool serves one call at a time, nested calls and calls from
+// other threads run on their own thread instead of waiting for it.
+TEST(ParallelTest, NestedAndConcurrentCalls) {
+  const auto list = make_list<yall::Yall<int>>(length);
+  std::atomic<std::size_t> inner{0};
+  yall::par_for_each(
+          list,
+          [&](int val) {
+            if (val % 20'000 == 0) {
+              inner += yall::par_count_if(list, [](int v) { return v < 10; },
+                                          4);
+            }
+          },
+          4);
+  EXPECT_EQ(inner, 6 * 10);
+
+  std::vector<std::size_t> counts(4);
+  {
+    std::vector<std::jthread> callers;
+    for (std::size_t t = 0; t < counts.size(); ++t) {
+      callers.emplace_back([&, t] {
+        for (int rep = 0; rep < 20; ++rep) {
+          counts[t] += yall::par_count_if(
+                  list, [](int v) { return v % 2 == 0; }, 3);
+        }
+      });
+    }
+  }
+  for (auto n: counts) {
+    EXPECT_EQ(n, 20 * ((length + 1) / 2));
+  }
+}
@@ -0,0 +1,70 @@
+#include "yall_simd.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+template<typename T>
+class SimdTest : public ::testing::Test {};
+
+using Arithmetic = ::testing::Types<std::int8_t, std::uint16_t, std::int32_t,
+                                    std::uint32_t, std::int64_t, float, double>;
+TYPED_TEST_SUITE(SimdTest, Arithmetic);
+
+// Every length up to a few vectors, with the matches at every position,
+// against the plain loops.
+TYPED_TEST(SimdTest, MatchesScalar) {
+  using T = TypeParam;
+  std::mt19937 rng(3);
+  for (std::size_t n = 0; n < 80; ++n) {
+    std::vector<T> vals(n);
+    for (auto& val: vals) {
+      val = static_cast<T>(rng() % 5);
+    }
+    for (int k = 0; k < 6; ++k) {
+      const auto val = static_cast<T>(k);
+      std::size_t first = n;
+      std::size_t last  = n;
+      std::size_t found = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        if (vals[i] == val) {
+          first = first == n ? i : first;
+          last  = i;
+          ++found;
+        }
+      }
+      ASSERT_EQ(yall::simd::find(vals.data(), n, val), first) << n << ' ' << k;
+      ASSERT_EQ(yall::simd::rfind(vals.data(), n, val), last) << n << ' ' << k;
+      ASSERT_EQ(yall::simd::count(vals.data(), n, val), found) << n << ' ' << k;
+    }
+  }
+}
+
+// Only whole values match, not a byte or a half of one.
+TYPED_TEST(SimdTest, WholeValues) {
+  using T = TypeParam;
+  if constexpr (std::is_integral_v<T> && sizeof(T) > 1) {
+    std::vector<T> vals(64, T{0});
+    vals[40] = static_cast<T>(T{1} << (sizeof(T) * 8 - 2));
+    EXPECT_EQ(yall::simd::find(vals.data(), vals.size(), T{1}), vals.size());
+    EXPECT_EQ(yall::simd::find(vals.data(), vals.size(), vals[40]), 40);
+    EXPECT_EQ(yall::simd::count(vals.data(), vals.size(), T{0}), 63);
+  }
+}
+
+TYPED_TEST(SimdTest, FloatingPoint) {
+  using T = TypeParam;
+  if constexpr (std::is_floating_point_v<T>) {
+    std::vector<T> vals(40, T{1});
+    vals[3]  = std::numeric_limits<T>::quiet_NaN();
+    vals[20] = T{-0.0};
+    const auto nan = std::numeric_limits<T>::quiet_NaN();
+    EXPECT_EQ(yall::simd::find(vals.data(), vals.size(), nan), vals.size());
+    EXPECT_EQ(yall::simd::count(vals.data(), vals.size(), nan), 0);
+    EXPECT_EQ(yall::simd::find(vals.data(), vals.size(), T{0.0}), 20);
+    EXPECT_EQ(yall::simd::rfind(vals.data(), vals.size(), T{1}), 39);
+  }
+}
@@ -0,0 +1,153 @@
+#include "yall_skip.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  std::vector<int> to_vector(const yall::SkipYall<int>& list) {
+    std::vector<int> vec(list.begin(), list.end());
+    std::vector<int> rev;
+    for (auto it = list.crbegin(); it != list.crend(); --it) {
+      rev.push_back(*it);
+    }
+    EXPECT_EQ(vec, std::vector<int>(rev.rbegin(), rev.rend()));
+    EXPECT_EQ(vec.size(), list.size());
+    return vec;
+  }
+}// namespace
+
+TEST(SkipYallTest, FrontBack) {
+  yall::SkipYall<std::string> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_FALSE(list.front_val());
+  EXPECT_FALSE(list.pop_back_value());
+  list.pop_front();
+  list.pop_back();
+
+  list.push_back("b");
+  list.push_front("a");
+  list.emplace_back(2, 'c');
+  EXPECT_EQ(list.size(), 3);
+  EXPECT_EQ(list.front_val(), "a");
+  EXPECT_EQ(list.back_val(), "cc");
+
+  std::string val;
+  EXPECT_TRUE(list.back(val));
+  EXPECT_EQ(val, "cc");
+  EXPECT_EQ(list.pop_front_value(), "a");
+  EXPECT_EQ(list.pop_back_value(), "cc");
+  EXPECT_TRUE(list.remove_first("b"));
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(SkipYallTest, Positions) {
+  yall::SkipYall<int> list;
+  for (int i = 0; i < 10; ++i) {
+    list.insert_at(i, i * 10);
+  }
+  list.insert_at(0, -1);
+  list.insert_at(5, 35);
+  list.insert_at(100, 100);
+  EXPECT_EQ(to_vector(list),
+            (std::vector<int>{-1, 0, 10, 20, 30, 35, 40, 50, 60, 70, 80, 90,
+                              100}));
+
+  EXPECT_EQ(list.at(0), -1);
+  EXPECT_EQ(list.at(5), 35);
+  EXPECT_EQ(list.at(12), 100);
+  EXPECT_THROW(list.at(13), std::out_of_range);
+  list.at(1) = 5;
+  EXPECT_EQ(list.at(1), 5);
+
+  EXPECT_TRUE(list.erase_at(5));
+  EXPECT_TRUE(list.erase_at(0));
+  EXPECT_FALSE(list.erase_at(11));
+  EXPECT_EQ(to_vector(list),
+            (std::vector<int>{5, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100}));
+
+  auto it = list.iter_at(3);
+  EXPECT_EQ(*it, 30);
+  EXPECT_EQ(list.rank(it), 3);
+  EXPECT_EQ(list.rank(list.end()), list.size());
+  EXPECT_TRUE(list.iter_at(11) == list.end());
+
+  it = list.insert(it, 25);
+  EXPECT_EQ(list.rank(it), 3);
+  it = list.erase(list.iter_at(0));
+  EXPECT_EQ(*it, 10);
+  EXPECT_EQ(to_vector(list),
+            (std::vector<int>{10, 20, 25, 30, 40, 50, 60, 70, 80, 90, 100}));
+}
+
+// Random positional edits against a vector, checking every position and
+// rank now and then.
+TEST(SkipYallTest, MatchesVector) {
+  yall::SkipYall<int> list;
+  std::vector<int> model;
+  std::mt19937 gen(7);
+
+  for (int step = 0; step < 20'000; ++step) {
+    const auto indx = gen() % (model.size() + 1);
+    switch (gen() % 4) {
+      case 0:
+      case 1:
+        list.insert_at(indx, step);
+        model.insert(model.begin() + indx, step);
+        break;
+      case 2:
+        if (indx < model.size()) {
+          EXPECT_TRUE(list.erase_at(indx));
+          model.erase(model.begin() + indx);
+        } else {
+          EXPECT_FALSE(list.erase_at(indx));
+        }
+        break;
+      default:
+        if (indx < model.size()) {
+          ASSERT_EQ(list.at(indx), model[indx]);
+        }
+    }
+    if (step % 2000 == 0) {
+      ASSERT_EQ(to_vector(list), model);
+      size_t at = 0;
+      for (auto it = list.cbegin(); it != list.cend(); ++it, ++at) {
+        ASSERT_EQ(list.rank(it), at);
+        ASSERT_EQ(list.at(at), *it);
+      }
+    }
+  }
+
+  // drain from both ends, the lanes shrink back
+  while (!model.empty()) {
+    EXPECT_EQ(list.pop_front_value(), model.front());
+    model.erase(model.begin());
+    if (!model.empty()) {
+      EXPECT_EQ(list.pop_back_value(), model.back());
+      model.pop_back();
+    }
+  }
+  EXPECT_TRUE(list.empty());
+  list.push_back(1);
+  EXPECT_EQ(list.at(0), 1);
+  EXPECT_EQ(list.rank(list.begin()), 0);
+}
+
+TEST(SkipYallTest, Move) {
+  yall::SkipYall<int> list;
+  for (int i = 0; i < 1000; ++i) {
+    list.push_back(i);
+  }
+  auto other = std::move(list);
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(other.size(), 1000);
+  EXPECT_EQ(other.at(999), 999);
+
+  list = std::move(other);
+  EXPECT_EQ(list.at(500), 500);
+  list.insert_at(500, -1);
+  EXPECT_EQ(list.rank(list.iter_at(501)), 501);
+  EXPECT_EQ(list.at(501), 500);
+}
@@ -0,0 +1,137 @@
+#include "yall_small.hpp"
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+  template<typename List>
+  auto to_vector(const List& list) {
+    return std::vector<std::decay_t<decltype(*list.begin())>>(list.begin(),
+                                                              list.end());
+  }
+
+  template<typename List>
+  bool inside(const List& list, const void* ptr) {
+    const auto* obj  = reinterpret_cast<const char*>(&list);
+    const auto* byte = reinterpret_cast<const char*>(ptr);
+    return std::less_equal<>()(obj, byte) &&
+           std::less<>()(byte, obj + sizeof(list));
+  }
+}// namespace
+
+TEST(SmallTest, Operations) {
+  yall::SmallYall<int, 4> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_FALSE(list.pop_front_value());
+
+  list.push_back(2);
+  list.push_back(4);
+  list.push_front(1);
+  EXPECT_TRUE(list.insert_before(4, 3));
+  EXPECT_TRUE(list.insert_after(4, 6));
+  list.insert_at(4, 5);
+  list.insert_at(100, 7);
+  EXPECT_FALSE(list.insert_after(42, 0));
+  EXPECT_EQ(to_vector(list), (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(list.size(), 7);
+
+  EXPECT_TRUE(list.remove_first(4));
+  EXPECT_TRUE(list.remove_last(6));
+  EXPECT_FALSE(list.remove_last(42));
+  EXPECT_EQ(list.pop_front_value(), 1);
+  EXPECT_EQ(list.pop_back_value(), 7);
+  EXPECT_EQ(to_vector(list), (std::vector<int>{2, 3, 5}));
+
+  int val = 0;
+  EXPECT_TRUE(list.front(val));
+  EXPECT_EQ(val, 2);
+  EXPECT_TRUE(list.back(val));
+  EXPECT_EQ(val, 5);
+
+  std::vector<int> reversed;
+  for (auto it = list.crbegin(); it != list.crend(); --it) {
+    reversed.push_back(*it);
+  }
+  EXPECT_EQ(reversed, (std::vector<int>{5, 3, 2}));
+
+  auto it = list.find(3);
+  *it     = 30;
+  it      = list.erase(list.rfind(30));
+  EXPECT_EQ(*it, 5);
+  list.emplace(it, 4);
+  EXPECT_EQ(list.find(42), list.end());
+  EXPECT_EQ(to_vector(list), (std::vector<int>{2, 4, 5}));
+
+  list.reset();
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.inline_nodes(), 0);
+}
+
+// The first N nodes live in the list object, the rest on the heap, and
+// freed slots are used again.
+TEST(SmallTest, Spill) {
+  yall::SmallYall<std::string, 4> list;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(inside(list, &list.emplace_back(std::to_string(i))));
+  }
+  EXPECT_EQ(list.inline_nodes(), 4);
+  auto& spilled = list.emplace_back("4");
+  EXPECT_FALSE(inside(list, &spilled));
+  EXPECT_EQ(list.inline_nodes(), 4);
+  EXPECT_EQ(list.size(), 5);
+
+  list.pop_front();
+  EXPECT_EQ(list.inline_nodes(), 3);
+  EXPECT_TRUE(inside(list, &list.emplace_at(2, "x")));
+  EXPECT_EQ(to_vector(list),
+            (std::vector<std::string>{"1", "2", "x", "3", "4"}));
+}
+
+// Moves keep the order, heap nodes are handed over, inline values moved.
+TEST(SmallTest, Move) {
+  yall::SmallYall<std::unique_ptr<int>, 2> a;
+  for (int i = 0; i < 5; ++i) {
+    a.push_back(std::make_unique<int>(i));
+  }
+  a.pop_front();// frees a slot, so inline and heap nodes are mixed
+  a.push_back(std::make_unique<int>(5));
+  const auto* inline_val = &*a.begin();
+  const auto* heap_val   = &*std::next(a.begin());
+  ASSERT_TRUE(inside(a, inline_val));
+  ASSERT_FALSE(inside(a, heap_val));
+
+  yall::SmallYall<std::unique_ptr<int>, 2> b(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.inline_nodes(), 0);
+  ASSERT_EQ(b.size(), 5);
+  EXPECT_EQ(b.inline_nodes(), 2);
+  EXPECT_TRUE(inside(b, &*b.begin()));
+  EXPECT_EQ(&*std::next(b.begin()), heap_val);
+  std::vector<int> vals;
+  for (const auto& ptr: b) {
+    vals.push_back(*ptr);
+  }
+  EXPECT_EQ(vals, (std::vector<int>{1, 2, 3, 4, 5}));
+  EXPECT_EQ(**b.crbegin(), 5);
+
+  a.push_back(std::make_unique<int>(9));
+  b = std::move(a);
+  ASSERT_EQ(b.size(), 1);
+  EXPECT_EQ(**b.begin(), 9);
+
+  // nothing inline, the nodes are taken as they are
+  yall::SmallYall<std::unique_ptr<int>, 2> c;
+  for (int i = 0; i < 3; ++i) {
+    c.push_back(std::make_unique<int>(i));
+  }
+  c.pop_front();
+  c.pop_front();
+  const auto* last = &*c.begin();
+  b                = std::move(c);
+  EXPECT_EQ(&*b.begin(), last);
+  EXPECT_EQ(**b.crbegin(), 2);
+  EXPECT_TRUE(c.empty());
+}
@@ -0,0 +1,149 @@
+#include "yall.hpp"
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+  template<typename Ownership>
+  using CountedList =
+          yall::Yall<int, std::allocator<int>, Ownership, yall::CountingStats>;
+}// namespace
+
+// NoStats takes no room in the list.
+static_assert(sizeof(yall::Yall<int>) ==
+              sizeof(yall::Yall<int, std::allocator<int>,
+                                yall::SharedOwnership, yall::NoStats>));
+static_assert(sizeof(yall::Yall<int, std::allocator<int>,
+                                yall::UniqueOwnership>) ==
+              3 * sizeof(void*));
+
+template<typename Ownership>
+class StatsTest : public ::testing::Test {};
+
+using Ownerships =
+        ::testing::Types<yall::SharedOwnership, yall::UniqueOwnership>;
+TYPED_TEST_SUITE(StatsTest, Ownerships);
+
+TYPED_TEST(StatsTest, Operations) {
+  CountedList<TypeParam> list;
+  for (int i = 0; i < 10; ++i) {
+    list.push_back(i);
+  }
+  list.push_front(-1);
+  EXPECT_TRUE(list.remove_first(5));// visits -1 .. 5
+  EXPECT_FALSE(list.remove_first(42));
+  list.insert_at(3, 100);
+  EXPECT_EQ(list.size(), 11);
+  list.pop_back();
+
+  const auto stats = list.stats();
+  EXPECT_EQ(stats[yall::Op::push_back].calls, 10);
+  EXPECT_EQ(stats[yall::Op::push_front].calls, 1);
+  EXPECT_EQ(stats[yall::Op::push_back].visited, 0);
+
+  const auto& removes = stats[yall::Op::remove_first];
+  EXPECT_EQ(removes.calls, 2);
+  EXPECT_EQ(removes.visited, 7 + 10);
+  EXPECT_EQ(removes.histogram[yall::OpStats::bucket_of(7)], 1);
+  EXPECT_EQ(removes.histogram[yall::OpStats::bucket_of(10)], 1);
+
+  EXPECT_EQ(stats[yall::Op::insert_at].visited, 3);
+  EXPECT_EQ(stats[yall::Op::size].calls, 1);
+  EXPECT_EQ(stats[yall::Op::pop_back].calls, 1);
+
+  EXPECT_EQ(stats.allocations, 12);
+  EXPECT_EQ(stats.frees, 2);
+  EXPECT_EQ(stats.live_nodes, 10);
+  EXPECT_EQ(stats.peak_nodes, 11);
+  if constexpr (TypeParam::refcounted) {
+    EXPECT_GT(stats.ref_updates, 0);
+  } else {
+    EXPECT_EQ(stats.ref_updates, 0);
+  }
+
+  list.clear_stats();
+  EXPECT_EQ(list.stats()[yall::Op::push_back].calls, 0);
+  EXPECT_EQ(list.stats().peak_nodes, 10);
+  list.reset();
+  EXPECT_EQ(list.stats().frees, 10);
+  EXPECT_EQ(list.stats().live_nodes, 0);
+}
+
+TYPED_TEST(StatsTest, Callback) {
+  CountedList<TypeParam> list;
+  std::vector<std::pair<yall::Op, size_t>> seen;
+  list.set_stats_callback([&seen](yall::Op op, size_t visited) {
+    seen.emplace_back(op, visited);
+  });
+
+  list.push_back(1);
+  list.push_back(2);
+  list.find(2);
+  list.visit_until([](int val) { return val == 1; });
+  list.for_each([](int) {});
+  list.set_stats_callback({});
+  list.pop_front();
+
+  const std::vector<std::pair<yall::Op, size_t>> expected{
+          {yall::Op::push_back, 0},
+          {yall::Op::push_back, 0},
+          {yall::Op::find, 2},
+          {yall::Op::visit_until, 1},
+          {yall::Op::for_each, 2}};
+  EXPECT_EQ(seen, expected);
+}
+
+// reset and the destructor can't throw, they are counted without calling the
+// callback.
+TYPED_TEST(StatsTest, CallbackNotCalledOnReset) {
+  int calls = 0;
+  {
+    CountedList<TypeParam> list;
+    list.set_stats_callback([&calls](yall::Op, size_t) {
+      ++calls;
+      throw std::runtime_error("callback");
+    });
+    EXPECT_THROW(list.push_back(1), std::runtime_error);
+    EXPECT_EQ(calls, 1);
+    list.reset();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(list.stats()[yall::Op::reset].calls, 1);
+    EXPECT_EQ(list.stats()[yall::Op::reset].visited, 1);
+    EXPECT_EQ(list.stats().live_nodes, 0);
+
+    EXPECT_THROW(list.push_back(2), std::runtime_error);
+  }
+  EXPECT_EQ(calls, 2);
+}
+
+// Nodes moved between lists are live in the list that holds them, without
+// counting as allocations or frees.
+TYPED_TEST(StatsTest, Transfers) {
+  CountedList<TypeParam> a;
+  CountedList<TypeParam> b;
+  a.append_range(std::vector<int>{1, 2, 3});
+  b.append_range(std::vector<int>{4, 5});
+
+  a.splice(a.cend(), b);
+  EXPECT_EQ(a.stats().live_nodes, 5);
+  EXPECT_EQ(b.stats().live_nodes, 0);
+  EXPECT_EQ(a.stats().allocations, 3);
+  EXPECT_EQ(a.stats()[yall::Op::insert_range].calls, 1);
+
+  CountedList<TypeParam> c(std::move(a));
+  EXPECT_EQ(c.stats().live_nodes, 5);
+  EXPECT_EQ(a.stats().live_nodes, 0);
+  EXPECT_EQ(c.stats().frees, 0);
+
+  // removed nodes handed to another list move, the others are freed
+  EXPECT_EQ(c.remove_if([](int val) { return val > 3; }, b), 2);
+  EXPECT_EQ(c.remove_all(1), 1);
+  EXPECT_EQ(c.stats().live_nodes, 2);
+  EXPECT_EQ(c.stats().frees, 1);
+  EXPECT_EQ(b.stats().live_nodes, 2);
+  EXPECT_EQ(b.stats().allocations, 2);
+  EXPECT_EQ(c.stats()[yall::Op::remove_if].calls, 2);
+  EXPECT_EQ(c.stats()[yall::Op::remove_if].visited, 8);
+}
@@ -1,8 +1,15 @@
 #include "yall.hpp"
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <new>
 #include <numeric>
+#include <sstream>
 #include <ranges>
+#include <string>
+#include <vector>
 
 namespace {
   class Clazz {
@@ -31,6 +38,29 @@ namespace {
 
     int get() const { return data; }
   };
+
+  // counts how often values are copied or moved
+  struct Tracked {
+    static inline int copies = 0;
+    static inline int moves  = 0;
+
+    explicit Tracked(std::string s_ = "", int n_ = 0) : s(std::move(s_)), n(n_) {}
+    Tracked(const Tracked& other) : s(other.s), n(other.n) { ++copies; }
+    Tracked(Tracked&& other) noexcept : s(std::move(other.s)), n(other.n) {
+      ++moves;
+    }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&)      = default;
+
+    bool operator==(const Tracked& other) const {
+      return s == other.s && n == other.n;
+    }
+
+    static void clear() { copies = moves = 0; }
+
+    std::string s;
+    int n;
+  };
 }// namespace
 
 TEST(YallTest, FrontPushPop) {
@@ -527,3 +557,1003 @@ TEST(ConstIterTest, NoCopyRanges) {
     indx += 2;
   }
 }
+
+namespace {
+  // upstream resource that counts the calls that reach it
+  class CountingResource : public std::pmr::memory_resource {
+  public:
+    size_t allocs   = 0;
+    size_t deallocs = 0;
+    bool fail       = false;// throw instead of allocating
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+      if (fail) {
+        throw std::bad_alloc();
+      }
+      ++allocs;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+      ++deallocs;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+  };
+}// namespace
+
+TEST(PoolTest, NodesAreRecycled) {
+  CountingResource upstream;
+  {
+    yall::NodePool pool(16, &upstream);
+    yall::pmr::Yall<double> dlist(&pool);
+
+    for (int i = 0; i < 100; ++i) {
+      dlist.push_back(i);
+    }
+    EXPECT_EQ(pool.live_blocks(), 100);
+    for (int i = 0; i < 100; ++i) {
+      dlist.pop_front();
+    }
+    EXPECT_EQ(pool.live_blocks(), 0);
+
+    const auto upstream_allocs = upstream.allocs;
+    EXPECT_GT(upstream_allocs, 0);
+    EXPECT_EQ(upstream_allocs, pool.chunk_count());
+
+    // steady state churn must not go back to the upstream resource
+    for (int round = 0; round < 10; ++round) {
+      for (int i = 0; i < 100; ++i) {
+        dlist.push_front(i);
+      }
+      dlist.insert_at(50, -1.0);
+      dlist.insert_after(-1.0, -2.0);
+      dlist.insert_before(-1.0, -3.0);
+      EXPECT_TRUE(dlist.remove_first(-1.0));
+      EXPECT_TRUE(dlist.remove_last(-2.0));
+      while (!dlist.empty()) {
+        dlist.pop_back();
+      }
+    }
+    EXPECT_EQ(upstream.allocs, upstream_allocs);
+    EXPECT_EQ(pool.live_blocks(), 0);
+  }
+  EXPECT_EQ(upstream.allocs, upstream.deallocs);
+}
+
+// A failed chunk allocation leaves the count of live blocks alone.
+TEST(PoolTest, FailedGrowth) {
+  CountingResource upstream;
+  yall::NodePool pool(16, &upstream);
+  yall::pmr::Yall<double> dlist(&pool);
+  for (int i = 0; i < 16; ++i) {
+    dlist.push_back(i);
+  }
+  ASSERT_EQ(upstream.allocs, 1);
+
+  // the first chunk is full
+  upstream.fail = true;
+  EXPECT_THROW(dlist.push_back(16), std::bad_alloc);
+  EXPECT_EQ(dlist.size(), 16);
+  EXPECT_EQ(pool.live_blocks(), 16);
+
+  upstream.fail = false;
+  dlist.push_back(16);
+  EXPECT_EQ(pool.live_blocks(), 17);
+  dlist.reset();
+  EXPECT_EQ(pool.live_blocks(), 0);
+}
+
+// A reserved batch belongs to the size class of its first allocation.
+TEST(PoolTest, BatchPerSizeClass) {
+  yall::NodePool pool;
+  void* other = pool.allocate(32);
+  pool.deallocate(other, 32);
+
+  pool.reserve_next(4);
+  auto* first = static_cast<std::byte*>(pool.allocate(16));
+  // a block of another size is taken from its own free list
+  EXPECT_EQ(pool.allocate(32), other);
+  for (int i = 1; i < 4; ++i) {
+    EXPECT_EQ(pool.allocate(16), first + i * 16);
+  }
+  EXPECT_EQ(pool.live_blocks(), 5);
+}
+
+TEST(PoolTest, SharedPool) {
+  yall::NodePool pool;
+  yall::pmr::Yall<int> ilist(&pool);
+  yall::pmr::Yall<yall::pmr::Yall<int>*> plist(&pool);
+
+  EXPECT_EQ(ilist.get_allocator().resource(), &pool);
+
+  for (int i = 0; i < 10; ++i) {
+    ilist.push_back(i);
+    plist.push_back(&ilist);
+  }
+  EXPECT_EQ(pool.live_blocks(), 20);
+  ilist.reset();
+  plist.reset();
+  EXPECT_EQ(pool.live_blocks(), 0);
+}
+
+template<typename Ownership>
+class OwnershipTest : public ::testing::Test {};
+
+using OwnershipTypes =
+        ::testing::Types<yall::SharedOwnership, yall::UniqueOwnership>;
+TYPED_TEST_SUITE(OwnershipTest, OwnershipTypes);
+
+TYPED_TEST(OwnershipTest, Mutations) {
+  yall::Yall<int, std::allocator<int>, TypeParam> ilist;
+
+  for (int i = 0; i < 10; ++i) {
+    ilist.push_back(i);
+    ilist.push_front(-i);
+  }
+  ilist.pop_front();
+  ilist.pop_back();
+  EXPECT_TRUE(ilist.insert_before(0, 100));
+  EXPECT_TRUE(ilist.insert_after(8, 200));
+  EXPECT_TRUE(ilist.remove_first(-8));
+  EXPECT_TRUE(ilist.remove_last(0));
+  ilist.insert_at(3, 300);
+
+  std::array<int, 19> expected = {-7, -6, -5, 300, -4, -3, -2, -1, 100, 0,
+                                  1,  2,  3,  4,   5,  6,  7,  8,  200};
+  ASSERT_EQ(ilist.size(), expected.size());
+
+  size_t indx = 0;
+  for (auto n: ilist) {
+    EXPECT_EQ(n, expected[indx++]);
+  }
+  for (auto it = ilist.crbegin(); it != ilist.crend(); --it) {
+    EXPECT_EQ(*it, expected[--indx]);
+  }
+  EXPECT_EQ(ilist.front_val(), -7);
+  EXPECT_EQ(ilist.back_val(), 200);
+
+  EXPECT_TRUE(ilist.remove_first(200));
+  EXPECT_EQ(ilist.back_val(), 8);
+  EXPECT_TRUE(ilist.remove_last(-7));
+  EXPECT_EQ(ilist.front_val(), -6);
+
+  ilist.reset();
+  EXPECT_TRUE(ilist.empty());
+  EXPECT_FALSE(ilist.back_val().has_value());
+}
+
+TYPED_TEST(OwnershipTest, PoolNodes) {
+  yall::NodePool pool;
+  {
+    yall::pmr::Yall<double, TypeParam> dlist(&pool);
+    for (int i = 0; i < 100; ++i) {
+      dlist.push_back(i);
+    }
+    EXPECT_EQ(pool.live_blocks(), 100);
+    dlist.remove_first(50.0);
+    dlist.pop_back();
+    EXPECT_EQ(pool.live_blocks(), 98);
+  }
+  EXPECT_EQ(pool.live_blocks(), 0);
+}
+
+TEST(OwnershipTest, ReferencePayload) {
+  using SharedNodeList = yall::Yall<int&>;
+  using UniqueNodeList =
+          yall::Yall<int&, std::allocator<int>, yall::UniqueOwnership>;
+
+  int vals[3] = {1, 2, 3};
+  UniqueNodeList ulist;
+  SharedNodeList slist;
+  for (auto& v: vals) {
+    ulist.push_back(v);
+    slist.push_back(v);
+  }
+  vals[1] = 42;
+  EXPECT_EQ(*++ulist.cbegin(), 42);
+  EXPECT_EQ(*++slist.cbegin(), 42);
+}
+
+TEST(YallTest, SizeTracking) {
+  yall::Yall<int> ilist;
+  EXPECT_EQ(ilist.size(), 0);
+  EXPECT_TRUE(ilist.empty());
+
+  ilist.push_back(1);
+  EXPECT_EQ(ilist.size(), 1);
+  EXPECT_FALSE(ilist.empty());
+  ilist.push_front(0);
+  EXPECT_EQ(ilist.size(), 2);
+  ilist.push_back(3);
+  EXPECT_EQ(ilist.size(), 3);
+
+  EXPECT_TRUE(ilist.insert_before(3, 2));
+  EXPECT_EQ(ilist.size(), 4);
+  EXPECT_TRUE(ilist.insert_after(3, 4));
+  EXPECT_EQ(ilist.size(), 5);
+  EXPECT_FALSE(ilist.insert_before(42, 5));
+  EXPECT_EQ(ilist.size(), 5);
+  EXPECT_FALSE(ilist.insert_after(42, 5));
+  EXPECT_EQ(ilist.size(), 5);
+
+  ilist.insert_at(0, -1);
+  EXPECT_EQ(ilist.size(), 6);
+  ilist.insert_at(3, 7);
+  EXPECT_EQ(ilist.size(), 7);
+  ilist.insert_at(99, 5);
+  EXPECT_EQ(ilist.size(), 8);
+
+  EXPECT_TRUE(ilist.remove_first(7));
+  EXPECT_EQ(ilist.size(), 7);
+  EXPECT_FALSE(ilist.remove_first(7));
+  EXPECT_EQ(ilist.size(), 7);
+  EXPECT_TRUE(ilist.remove_last(-1));
+  EXPECT_EQ(ilist.size(), 6);
+  EXPECT_FALSE(ilist.remove_last(-1));
+  EXPECT_EQ(ilist.size(), 6);
+
+  ilist.pop_front();
+  EXPECT_EQ(ilist.size(), 5);
+  ilist.pop_back();
+  EXPECT_EQ(ilist.size(), 4);
+
+  size_t walked = 0;
+  for ([[maybe_unused]] auto n: ilist) {
+    ++walked;
+  }
+  EXPECT_EQ(walked, ilist.size());
+
+  ilist.reset();
+  EXPECT_EQ(ilist.size(), 0);
+  EXPECT_TRUE(ilist.empty());
+
+  // popping an empty list leaves the count alone
+  ilist.pop_front();
+  ilist.pop_back();
+  EXPECT_EQ(ilist.size(), 0);
+  EXPECT_TRUE(ilist.empty());
+}
+
+TYPED_TEST(OwnershipTest, LongListTeardown) {
+  // deep enough to overflow the stack if nodes were freed recursively
+  constexpr size_t sz = 1'000'000;
+  {
+    yall::Yall<int, std::allocator<int>, TypeParam> ilist;
+    for (size_t i = 0; i < sz; ++i) {
+      ilist.push_back(static_cast<int>(i));
+    }
+    EXPECT_EQ(ilist.size(), sz);
+  }
+  yall::Yall<int, std::allocator<int>, TypeParam> ilist;
+  for (size_t i = 0; i < sz; ++i) {
+    ilist.push_front(static_cast<int>(i));
+  }
+  ilist.reset();
+  EXPECT_TRUE(ilist.empty());
+}
+
+TEST(PoolTest, BulkReset) {
+  CountingResource upstream;
+  yall::NodePool pool(16, &upstream);
+  yall::pmr::Yall<int, yall::UniqueOwnership> ilist(&pool);
+
+  for (int i = 0; i < 1000; ++i) {
+    ilist.push_back(i);
+  }
+  const auto chunks = pool.chunk_count();
+  const auto allocs = upstream.allocs;
+  ilist.reset();
+  EXPECT_TRUE(ilist.empty());
+  EXPECT_EQ(pool.live_blocks(), 0);
+  EXPECT_EQ(pool.chunk_count(), chunks);
+
+  for (int i = 0; i < 1000; ++i) {
+    ilist.push_front(i);
+  }
+  EXPECT_EQ(upstream.allocs, allocs);
+  EXPECT_EQ(ilist.size(), 1000);
+  EXPECT_EQ(ilist.front_val(), 999);
+  EXPECT_EQ(ilist.back_val(), 0);
+
+  // a second list in the same pool keeps its nodes
+  yall::pmr::Yall<int, yall::UniqueOwnership> other(&pool);
+  other.push_back(7);
+  ilist.reset();
+  EXPECT_EQ(pool.live_blocks(), 1);
+  EXPECT_EQ(other.front_val(), 7);
+}
+
+// The big nodes go upstream and aren't pool blocks, the pool's count of
+// blocks matching the big list's size must not make it recycle the small
+// list's nodes.
+TEST(PoolTest, BulkResetSharedSizes) {
+  CountingResource upstream;
+  yall::NodePool pool(16, &upstream);
+  yall::pmr::Yall<std::array<char, 1000>, yall::UniqueOwnership> big(&pool);
+  yall::pmr::Yall<int, yall::UniqueOwnership> small(&pool);
+  for (int i = 0; i < 3; ++i) {
+    big.push_back({});
+    small.push_back(i);
+  }
+  EXPECT_EQ(pool.live_blocks(), 3);
+  EXPECT_EQ(pool.live_blocks(sizeof(std::array<char, 1000>), 1), 0);
+
+  const auto deallocs = upstream.deallocs;
+  big.reset();
+  EXPECT_EQ(upstream.deallocs, deallocs + 3);
+  EXPECT_EQ(pool.live_blocks(), 3);
+
+  small.push_back(100);
+  EXPECT_EQ(std::accumulate(small.begin(), small.end(), 0), 103);
+  EXPECT_EQ(pool.live_blocks(), 4);
+}
+
+TEST(MoveTest, PushAndEmplace) {
+  yall::Yall<Tracked> tlist;
+  Tracked::clear();
+
+  tlist.push_back(Tracked("one", 1));
+  tlist.push_front(Tracked("zero", 0));
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 2);
+
+  Tracked::clear();
+  auto& two = tlist.emplace_back("two", 2);
+  EXPECT_EQ(two.n, 2);
+  tlist.emplace_front("minus one", -1);
+  tlist.emplace_at(2, "half", 5);
+  EXPECT_TRUE(tlist.insert_after(Tracked("two", 2), Tracked("three", 3)));
+  EXPECT_TRUE(tlist.insert_before(Tracked("two", 2), Tracked("1.5", 15)));
+  tlist.insert_at(0, Tracked("minus two", -2));
+  EXPECT_EQ(Tracked::copies, 0);
+
+  std::array<int, 8> expected = {-2, -1, 0, 5, 1, 15, 2, 3};
+  ASSERT_EQ(tlist.size(), expected.size());
+  size_t indx = 0;
+  for (const auto& t: tlist) {
+    EXPECT_EQ(t.n, expected[indx++]);
+  }
+
+  Tracked::clear();
+  auto front = tlist.pop_front_value();
+  ASSERT_TRUE(front.has_value());
+  EXPECT_EQ(front->s, "minus two");
+  auto back = tlist.pop_back_value();
+  ASSERT_TRUE(back.has_value());
+  EXPECT_EQ(back->s, "three");
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(tlist.size(), 6);
+
+  tlist.reset();
+  EXPECT_FALSE(tlist.pop_front_value().has_value());
+  EXPECT_FALSE(tlist.pop_back_value().has_value());
+}
+
+TEST(MoveTest, MoveOnlyPayload) {
+  yall::Yall<std::unique_ptr<int>, std::allocator<int>, yall::UniqueOwnership>
+          plist;
+  plist.push_back(std::make_unique<int>(1));
+  plist.emplace_back(new int(2));
+  plist.emplace_front(std::make_unique<int>(0));
+
+  auto p0 = plist.pop_front_value();
+  ASSERT_TRUE(p0.has_value());
+  EXPECT_EQ(**p0, 0);
+  auto p2 = plist.pop_back_value();
+  ASSERT_TRUE(p2.has_value());
+  EXPECT_EQ(**p2, 2);
+  EXPECT_EQ(plist.size(), 1);
+}
+
+TEST(MoveTest, ReferencePayloadIsNotMovedFrom) {
+  std::string s = "client data";
+  yall::Yall<std::string&> slist;
+  slist.push_back(s);
+  auto val = slist.pop_front_value();
+  ASSERT_TRUE(val.has_value());
+  EXPECT_EQ(*val, "client data");
+  EXPECT_EQ(s, "client data");
+}
+
+namespace {
+  yall::Yall<int> make_list(int n) {
+    yall::Yall<int> ilist;
+    for (int i = 0; i < n; ++i) {
+      ilist.push_back(i);
+    }
+    return ilist;
+  }
+}// namespace
+
+TEST(MoveTest, MoveList) {
+  auto ilist = make_list(10);
+  EXPECT_EQ(ilist.size(), 10);
+
+  yall::Yall<int> other(std::move(ilist));
+  EXPECT_TRUE(ilist.empty());
+  EXPECT_EQ(other.size(), 10);
+  EXPECT_EQ(other.front_val(), 0);
+  EXPECT_EQ(other.back_val(), 9);
+
+  ilist = make_list(3);
+  ilist = std::move(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(ilist.size(), 10);
+  EXPECT_EQ(ilist.back_val(), 9);
+
+  // the moved-from list is still usable
+  other.push_back(42);
+  EXPECT_EQ(other.front_val(), 42);
+}
+
+TYPED_TEST(OwnershipTest, MoveBetweenPools) {
+  yall::NodePool pool1;
+  yall::NodePool pool2;
+  yall::pmr::Yall<Tracked, TypeParam> tlist1(&pool1);
+  yall::pmr::Yall<Tracked, TypeParam> tlist2(&pool2);
+  yall::pmr::Yall<Tracked, TypeParam> tlist3(&pool1);
+
+  for (int i = 0; i < 5; ++i) {
+    tlist1.emplace_back("x", i);
+  }
+  Tracked::clear();
+
+  // different resources, values are moved into new nodes
+  tlist2 = std::move(tlist1);
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 5);
+  EXPECT_EQ(pool1.live_blocks(), 0);
+  EXPECT_EQ(pool2.live_blocks(), 5);
+  EXPECT_TRUE(tlist1.empty());
+  EXPECT_EQ(tlist2.size(), 5);
+  EXPECT_EQ(tlist2.back_val()->n, 4);
+
+  // same resource, the nodes are handed over
+  tlist1.emplace_back("y", 1);
+  Tracked::clear();
+  tlist3 = std::move(tlist1);
+  EXPECT_EQ(Tracked::moves, 0);
+  EXPECT_EQ(pool1.live_blocks(), 1);
+  EXPECT_EQ(tlist3.front_val()->s, "y");
+}
+
+namespace {
+  template<typename List>
+  std::vector<int> to_vector(List& list) {
+    std::vector<int> vec;
+    for (auto n: list) {
+      vec.push_back(n);
+    }
+    return vec;
+  }
+}// namespace
+
+TYPED_TEST(OwnershipTest, PositionInsertErase) {
+  yall::Yall<int, std::allocator<int>, TypeParam> ilist;
+
+  // the insert position doesn't depend on the values, duplicates included
+  auto it = ilist.insert(ilist.cend(), 1);
+  EXPECT_EQ(*it, 1);
+  it = ilist.insert(it, 1);
+  it = ilist.insert(it, 0);
+  ilist.insert(ilist.cend(), 1);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{0, 1, 1, 1}));
+
+  ilist.insert_at(2, 7);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{0, 1, 7, 1, 1}));
+
+  auto pos = ilist.find(7);
+  ASSERT_NE(pos, ilist.end());
+  *pos = 2;// mutable access through the search result
+  pos  = ilist.emplace(++pos, 3);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{0, 1, 2, 3, 1, 1}));
+  EXPECT_EQ(ilist.size(), 6);
+
+  auto last = ilist.rfind(1);
+  ASSERT_NE(last, ilist.end());
+  *last = 5;
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{0, 1, 2, 3, 1, 5}));
+  EXPECT_EQ(ilist.find(42), ilist.end());
+  EXPECT_EQ(ilist.rfind(42), ilist.end());
+
+  auto next = ilist.erase(ilist.find(2));
+  EXPECT_EQ(*next, 3);
+  next = ilist.erase(ilist.rfind(5));
+  EXPECT_EQ(next, ilist.end());
+  EXPECT_EQ(ilist.back_val(), 1);
+  next = ilist.erase(ilist.cbegin());
+  EXPECT_EQ(*next, 1);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{1, 3, 1}));
+  EXPECT_EQ(ilist.size(), 3);
+
+  for (int i = 4; i < 8; ++i) {
+    ilist.push_back(i);
+  }
+  auto first = ilist.find(3);
+  auto stop  = ilist.find(6);
+  next       = ilist.erase(first, stop);
+  EXPECT_EQ(*next, 6);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{1, 6, 7}));
+  EXPECT_EQ(ilist.size(), 3);
+
+  ilist.erase(ilist.cbegin(), ilist.cend());
+  EXPECT_TRUE(ilist.empty());
+  EXPECT_FALSE(ilist.back_val().has_value());
+}
+
+namespace {
+  // forward and backward traversal must agree
+  template<typename List>
+  std::vector<int> to_vector_checked(List& list) {
+    auto vec = to_vector(list);
+    std::vector<int> rev;
+    for (auto it = list.crbegin(); it != list.crend(); --it) {
+      rev.push_back(*it);
+    }
+    std::reverse(rev.begin(), rev.end());
+    EXPECT_EQ(vec, rev);
+    EXPECT_EQ(vec.size(), list.size());
+    return vec;
+  }
+}// namespace
+
+TYPED_TEST(OwnershipTest, Splice) {
+  using List = yall::Yall<int, std::allocator<int>, TypeParam>;
+  List a;
+  List b;
+  for (int i = 0; i < 5; ++i) {
+    a.push_back(i);
+    b.push_back(10 + i);
+  }
+
+  a.splice(a.find(2), b, b.find(12));
+  EXPECT_EQ(to_vector_checked(a), (std::vector<int>{0, 1, 12, 2, 3, 4}));
+  EXPECT_EQ(to_vector_checked(b), (std::vector<int>{10, 11, 13, 14}));
+
+  a.splice(a.cend(), b, b.find(11), b.cend());
+  EXPECT_EQ(to_vector_checked(a),
+            (std::vector<int>{0, 1, 12, 2, 3, 4, 11, 13, 14}));
+  EXPECT_EQ(to_vector_checked(b), (std::vector<int>{10}));
+
+  a.splice(a.cbegin(), b);
+  EXPECT_EQ(to_vector_checked(a),
+            (std::vector<int>{10, 0, 1, 12, 2, 3, 4, 11, 13, 14}));
+  EXPECT_TRUE(b.empty());
+  EXPECT_FALSE(b.front_val().has_value());
+
+  // within the same list
+  a.splice(a.cbegin(), a, a.find(14));
+  a.splice(a.cend(), a, a.cbegin());
+  a.splice(a.find(11), a, a.find(0), a.find(2));
+  EXPECT_EQ(to_vector_checked(a),
+            (std::vector<int>{10, 2, 3, 4, 0, 1, 12, 11, 13, 14}));
+  a.splice(a.find(3), a, a.find(3));// no-op
+  a.splice(a.find(4), a, a.find(3));// no-op
+  EXPECT_EQ(to_vector_checked(a),
+            (std::vector<int>{10, 2, 3, 4, 0, 1, 12, 11, 13, 14}));
+
+  b.push_back(99);
+  b.splice(b.cbegin(), a, a.cbegin(), a.cend());
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b.size(), 11);
+  EXPECT_EQ(b.back_val(), 99);
+  EXPECT_EQ(b.front_val(), 10);
+}
+
+TYPED_TEST(OwnershipTest, MoveToFront) {
+  using List = yall::Yall<int, std::allocator<int>, TypeParam>;
+  List list;
+  list.push_back(0);
+  list.move_to_front(list.cbegin());
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{0}));
+
+  for (int i = 1; i < 5; ++i) {
+    list.push_back(i);
+  }
+  const int* two = &*list.find(2);
+  list.move_to_front(list.find(2));
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{2, 0, 1, 3, 4}));
+  EXPECT_EQ(&list.front_ref(), two);
+  list.move_to_front(list.find(4));
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{4, 2, 0, 1, 3}));
+  EXPECT_EQ(list.back_ref(), 3);
+  list.move_to_front(list.cbegin());
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{4, 2, 0, 1, 3}));
+  EXPECT_EQ(list.size(), 5);
+}
+
+TYPED_TEST(OwnershipTest, MergeSort) {
+  yall::NodePool pool;
+  using List = yall::pmr::Yall<Tracked, TypeParam>;
+  List a(&pool);
+  List b(&pool);
+  auto by_n  = [](const Tracked& x, const Tracked& y) { return x.n < y.n; };
+  for (int i = 0; i < 10; i += 2) {
+    a.emplace_back("a", i);
+    b.emplace_back("b", i);
+  }
+  b.emplace_back("b", 11);
+
+  Tracked::clear();
+  const auto blocks = pool.live_blocks();
+  a.merge(b, by_n);
+  EXPECT_TRUE(b.empty());
+  ASSERT_EQ(a.size(), 11);
+  EXPECT_EQ(pool.live_blocks(), blocks);
+  EXPECT_EQ(Tracked::copies + Tracked::moves, 0);
+
+  std::string order;
+  for (const auto& t: a) {
+    order += t.s;
+  }
+  // stable: on equal keys the nodes of this list come first
+  EXPECT_EQ(order, "abababababb");
+  EXPECT_EQ(a.back_val()->n, 11);
+
+  // stable sort on a key with many duplicates
+  List c(&pool);
+  for (int i = 0; i < 1000; ++i) {
+    c.emplace_back(std::to_string(i), (i * 7919) % 13);
+  }
+  Tracked::clear();
+  c.sort(by_n);
+  EXPECT_EQ(Tracked::copies + Tracked::moves, 0);
+  ASSERT_EQ(c.size(), 1000);
+
+  const Tracked* prev = nullptr;
+  for (const auto& t: c) {
+    if (prev) {
+      EXPECT_LE(prev->n, t.n);
+      if (prev->n == t.n) {
+        EXPECT_LT(std::stoi(prev->s), std::stoi(t.s));
+      }
+    }
+    prev = &t;
+  }
+  size_t walked = 0;
+  for (auto it = c.crbegin(); it != c.crend(); --it) {
+    ++walked;
+  }
+  EXPECT_EQ(walked, 1000);
+}
+
+TEST(YallTest, Sort) {
+  yall::Yall<int> ilist;
+  ilist.sort();
+  EXPECT_TRUE(ilist.empty());
+
+  std::vector<int> expected;
+  unsigned seed = 12345;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    ilist.push_back(static_cast<int>(seed % 1000));
+    expected.push_back(static_cast<int>(seed % 1000));
+  }
+  std::sort(expected.begin(), expected.end());
+  ilist.sort();
+  EXPECT_EQ(to_vector_checked(ilist), expected);
+
+  ilist.sort(std::greater<>());
+  std::reverse(expected.begin(), expected.end());
+  EXPECT_EQ(to_vector_checked(ilist), expected);
+  EXPECT_EQ(ilist.front_val(), expected.front());
+  EXPECT_EQ(ilist.back_val(), expected.back());
+}
+
+TYPED_TEST(OwnershipTest, Ranges) {
+  using List = yall::Yall<int, std::allocator<int>, TypeParam>;
+  const std::vector<int> vec{1, 2, 3};
+
+  List ilist(vec);
+  EXPECT_EQ(to_vector_checked(ilist), vec);
+
+  ilist.append_range(std::views::iota(4, 7));
+  ilist.prepend_range(std::vector<int>{-1, 0});
+  EXPECT_EQ(to_vector_checked(ilist),
+            (std::vector<int>{-1, 0, 1, 2, 3, 4, 5, 6}));
+
+  auto pos = std::next(ilist.cbegin(), 2);
+  auto it  = ilist.insert_range(pos, vec.begin(), vec.end());
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(std::distance(ilist.cbegin(), typename List::ConstIterator(it)),
+            2);
+  EXPECT_EQ(to_vector_checked(ilist),
+            (std::vector<int>{-1, 0, 1, 2, 3, 1, 2, 3, 4, 5, 6}));
+
+  // an empty range leaves the list alone and returns pos
+  EXPECT_EQ(ilist.insert_range(pos, vec.end(), vec.end()), pos);
+  EXPECT_EQ(ilist.size(), 11);
+
+  // input ranges without a known size
+  auto odd = std::views::iota(0, 10) |
+             std::views::filter([](int n) { return n % 2 == 1; });
+  List from_iters(odd.begin(), odd.end());
+  EXPECT_EQ(to_vector_checked(from_iters), (std::vector<int>{1, 3, 5, 7, 9}));
+  from_iters.insert_range(from_iters.cend(), odd);
+  EXPECT_EQ(from_iters.size(), 10);
+  EXPECT_EQ(from_iters.back_val(), 9);
+
+  List empty(std::vector<int>{});
+  EXPECT_TRUE(empty.empty());
+  empty.append_range(vec);
+  EXPECT_EQ(to_vector_checked(empty), vec);
+}
+
+TEST(YallTest, ReferenceRange) {
+  std::vector<double> vals{1.0, 2.0, 3.0};
+  yall::Yall<double&> dlist(vals);
+  vals[1] = 20.0;
+  EXPECT_EQ(dlist.front_val(), 1.0);
+  dlist.pop_front();
+  EXPECT_EQ(dlist.front_val(), 20.0);
+}
+
+// a sized range is carved from one run of pool blocks
+TYPED_TEST(OwnershipTest, PoolRange) {
+  yall::NodePool pool(4);
+  yall::pmr::Yall<double, TypeParam> dlist(&pool);
+  dlist.push_back(-1.0);
+  dlist.push_back(-2.0);
+  dlist.pop_back();// leaves a block on the free list
+
+  std::vector<double> vals(1000);
+  std::iota(vals.begin(), vals.end(), 0.0);
+  dlist.append_range(vals);
+  EXPECT_EQ(dlist.size(), 1001);
+  EXPECT_EQ(pool.live_blocks(), 1001);
+  EXPECT_EQ(pool.chunk_count(), 2);
+
+  auto addr = [](const double& d) {
+    return reinterpret_cast<std::uintptr_t>(&d);
+  };
+  auto it           = std::next(dlist.cbegin());
+  auto prev         = addr(*it);
+  const auto stride = addr(*std::next(it)) - prev;
+  for (++it; it != dlist.cend(); ++it) {
+    EXPECT_EQ(addr(*it) - prev, stride);
+    prev = addr(*it);
+  }
+
+  // the free block is used again afterwards
+  dlist.push_back(1000.0);
+  EXPECT_EQ(pool.chunk_count(), 2);
+  EXPECT_EQ(pool.live_blocks(), 1002);
+}
+
+TYPED_TEST(OwnershipTest, InPlaceAccess) {
+  using List = yall::Yall<Tracked, std::allocator<Tracked>, TypeParam>;
+  List list;
+  list.emplace_back("a", 1);
+  list.emplace_back("b", 2);
+  list.emplace_back("c", 3);
+  Tracked::clear();
+
+  EXPECT_EQ(list.front_ref().s, "a");
+  EXPECT_EQ(list.back_ref().s, "c");
+  list.front_ref().n = 10;
+  list.back_ref().s += "c";
+  for (auto& val: list) {
+    val.n *= 2;
+  }
+  for (auto it = list.begin(); it != list.end(); ++it) {
+    it->s += "!";
+  }
+  EXPECT_EQ(Tracked::copies, 0);
+  EXPECT_EQ(Tracked::moves, 0);
+
+  const List& view = list;
+  static_assert(std::is_same_v<decltype(view.begin()),
+                               typename List::ConstIterator>);
+  static_assert(std::is_same_v<decltype(view.front_ref()), const Tracked&>);
+  static_assert(std::is_same_v<decltype(view.cbegin().operator->()),
+                               const Tracked*>);
+  std::vector<int> ns;
+  for (auto it = view.begin(); it != view.end(); ++it) {
+    ns.push_back(it->n);
+  }
+  EXPECT_EQ(ns, (std::vector<int>{20, 4, 6}));
+  EXPECT_EQ(view.front_ref().s, "a!");
+  EXPECT_EQ(view.back_ref().s, "cc!");
+  EXPECT_EQ(view.crbegin()->n, 6);
+
+  list.pop_front();
+  EXPECT_EQ(list.front_ref().s, "b!");
+}
+
+TEST(YallTest, InPlaceReferencePayload) {
+  NoCopy obj0(1);
+  NoCopy obj1(2);
+  yall::Yall<const NoCopy&> ll_nc;
+  ll_nc.push_back(obj0);
+  ll_nc.push_back(obj1);
+  EXPECT_EQ(&ll_nc.front_ref(), &obj0);
+  EXPECT_EQ(&ll_nc.back_ref(), &obj1);
+  EXPECT_EQ(ll_nc.begin()->get(), 1);
+
+  int vals[2] = {1, 2};
+  yall::Yall<int&> refs;
+  refs.push_back(vals[0]);
+  refs.push_back(vals[1]);
+  refs.back_ref() = 20;
+  for (int& val: refs) {
+    ++val;
+  }
+  EXPECT_EQ(vals[0], 2);
+  EXPECT_EQ(vals[1], 21);
+}
+
+TYPED_TEST(OwnershipTest, Visitors) {
+  yall::Yall<int, std::allocator<int>, TypeParam> list;
+  list.append_range(std::vector<int>{1, 2, 3, 4});
+
+  std::vector<int> seen;
+  list.for_each([&seen](int& val) {
+    seen.push_back(val);
+    val *= 10;
+  });
+  EXPECT_EQ(seen, (std::vector<int>{1, 2, 3, 4}));
+  seen.clear();
+  std::as_const(list).for_each_reverse(
+          [&seen](const int& val) { seen.push_back(val); });
+  EXPECT_EQ(seen, (std::vector<int>{40, 30, 20, 10}));
+  list.for_each_reverse([](int& val) { ++val; });
+  EXPECT_EQ(list.back_ref(), 41);
+
+  int calls = 0;
+  auto it   = list.visit_until([&calls](int val) {
+    ++calls;
+    return val > 15;
+  });
+  EXPECT_EQ(*it, 21);
+  EXPECT_EQ(calls, 2);
+  *it = 22;
+  EXPECT_EQ(std::as_const(list).visit_until([](int val) { return val < 0; }),
+            list.cend());
+
+  std::ostringstream os;
+  EXPECT_TRUE(list.write_to(os, [](std::ostream& out, int val) {
+    out << val << ',';
+  }));
+  EXPECT_EQ(os.str(), "11,22,31,41,");
+
+  // stops once the stream has failed
+  std::ostringstream failed;
+  failed.setstate(std::ios::badbit);
+  int writes = 0;
+  EXPECT_FALSE(list.write_to(failed, [&writes](std::ostream&, int) {
+    ++writes;
+  }));
+  EXPECT_EQ(writes, 0);
+
+  yall::Yall<int, std::allocator<int>, TypeParam> empty;
+  empty.for_each([](int) { FAIL(); });
+  empty.for_each_reverse([](int) { FAIL(); });
+  EXPECT_EQ(empty.visit_until([](int) { return true; }), empty.end());
+}
+
+TYPED_TEST(OwnershipTest, FindIf) {
+  yall::Yall<int, std::allocator<int>, TypeParam> list;
+  list.append_range(std::vector<int>{1, 4, 9, 16});
+  auto it = list.find_if([](int val) { return val > 3; });
+  EXPECT_EQ(*it, 4);
+  *it = 5;
+  EXPECT_EQ(*std::as_const(list).find_if([](int val) { return val % 2 == 0; }),
+            16);
+  EXPECT_EQ(list.find_if([](int val) { return val < 0; }), list.end());
+}
+
+// Lists long enough to be scanned with prefetching find the same nodes.
+TYPED_TEST(OwnershipTest, LongScans) {
+  const int n = static_cast<int>(yall::prefetch_min_size) + 100;
+  yall::Yall<int, std::allocator<int>, TypeParam> list;
+  for (int i = 0; i < n; ++i) {
+    list.push_back(i % 1000);
+  }
+  auto it = list.find_if([](int val) { return val == 999; });
+  EXPECT_EQ(*it, 999);
+  EXPECT_EQ(*++it, 0);
+  EXPECT_EQ(list.find_if([](int val) { return val > 1000; }), list.end());
+
+  // the last node is found too, with the runner past the end
+  list.push_back(-7);
+  EXPECT_EQ(list.find_if([](int val) { return val < 0; }), list.crbegin());
+  EXPECT_TRUE(list.remove_first(150));
+  EXPECT_TRUE(list.remove_last(99));
+  EXPECT_EQ(list.size(), n - 1);
+
+  long sum      = 0;
+  long expected = 0;
+  for (int val: list) {
+    expected += val;
+  }
+  list.for_each([&sum](int val) { sum += val; });
+  EXPECT_EQ(sum, expected);
+  sum = 0;
+  std::vector<int> tail_vals;
+  list.for_each_reverse([&](int val) {
+    sum += val;
+    if (tail_vals.size() < 3) {
+      tail_vals.push_back(val);
+    }
+  });
+  EXPECT_EQ(sum, expected);
+  EXPECT_EQ(tail_vals, (std::vector<int>{-7, 195, 194}));
+  EXPECT_EQ(*list.rfind(99), 99);
+  EXPECT_EQ(*std::next(list.rfind(99)), 100);
+}
+
+TYPED_TEST(OwnershipTest, RemoveIf) {
+  using List = yall::Yall<int, std::allocator<int>, TypeParam>;
+  List list;
+  EXPECT_EQ(list.remove_all(1), 0);
+  EXPECT_EQ(list.unique(), 0);
+
+  list.append_range(std::vector<int>{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5});
+  EXPECT_EQ(list.remove_if([](int val) { return val % 2 == 0; }), 3);
+  EXPECT_EQ(to_vector_checked(list),
+            (std::vector<int>{3, 1, 1, 5, 9, 5, 3, 5}));
+  EXPECT_EQ(list.size(), 8);
+
+  // the removed nodes keep their order at the back of the other list
+  List removed;
+  removed.push_back(0);
+  EXPECT_EQ(list.remove_all(5, removed), 3);
+  EXPECT_EQ(list.remove_all(42, removed), 0);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{3, 1, 1, 9, 3}));
+  EXPECT_EQ(to_vector_checked(removed), (std::vector<int>{0, 5, 5, 5}));
+
+  // first and last nodes
+  EXPECT_EQ(list.remove_all(3), 2);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{1, 1, 9}));
+  EXPECT_EQ(list.back_ref(), 9);
+
+  list.append_range(std::vector<int>{9, 9, 1});
+  EXPECT_EQ(list.unique(), 3);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{1, 9, 1}));
+  list.sort();
+  EXPECT_EQ(list.unique(), 1);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{1, 9}));
+
+  list.append_range(std::vector<int>{10, 20, 21, 30});
+  List close;
+  EXPECT_EQ(list.unique([](int a, int b) { return b - a < 5; }, close), 2);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{1, 9, 20, 30}));
+  EXPECT_EQ(to_vector_checked(close), (std::vector<int>{10, 21}));
+
+  EXPECT_EQ(list.remove_if([](int) { return true; }, close), 4);
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.cbegin(), list.cend());
+  EXPECT_EQ(close.size(), 6);
+  list.push_back(7);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{7}));
+
+  // handing the nodes to the list itself moves them to its back
+  EXPECT_EQ(close.remove_if([](int val) { return val < 10; }, close), 2);
+  EXPECT_EQ(to_vector_checked(close),
+            (std::vector<int>{10, 21, 20, 30, 1, 9}));
+  EXPECT_EQ(close.size(), 6);
+  EXPECT_EQ(close.remove_all(42, close), 0);
+  EXPECT_EQ(to_vector_checked(close),
+            (std::vector<int>{10, 21, 20, 30, 1, 9}));
+
+  list.append_range(std::vector<int>{7, 8, 8, 7});
+  List dups;
+  EXPECT_EQ(list.unique(dups), 2);
+  EXPECT_EQ(to_vector_checked(list), (std::vector<int>{7, 8, 7}));
+  EXPECT_EQ(to_vector_checked(dups), (std::vector<int>{7, 8}));
+}
+
+#ifndef NDEBUG
+// Nodes can only be handed to a list that can free them.
+TEST(YallTest, RemoveIntoOtherResource) {
+  yall::NodePool pool_a;
+  yall::NodePool pool_b;
+  yall::pmr::Yall<int> a(&pool_a);
+  yall::pmr::Yall<int> b(&pool_b);
+  a.push_back(1);
+  EXPECT_DEATH(a.remove_all(1, b), "alloc");
+}
+#endif
@@ -0,0 +1,220 @@
+#include "yall_unrolled.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  template<typename List>
+  std::vector<int> to_vector(const List& list) {
+    std::vector<int> vec;
+    for (auto n: list) {
+      vec.push_back(n);
+    }
+    std::vector<int> rev;
+    for (auto it = list.crbegin(); it != list.crend(); --it) {
+      rev.push_back(*it);
+    }
+    EXPECT_EQ(vec, std::vector<int>(rev.rbegin(), rev.rend()));
+    EXPECT_EQ(vec.size(), list.size());
+    return vec;
+  }
+}// namespace
+
+template<typename List>
+class UnrolledTest : public ::testing::Test {};
+
+using ChunkSizes = ::testing::Types<yall::UnrolledYall<int, 2>,
+                                    yall::UnrolledYall<int, 3>,
+                                    yall::UnrolledYall<int, 16>>;
+TYPED_TEST_SUITE(UnrolledTest, ChunkSizes);
+
+TYPED_TEST(UnrolledTest, FrontBack) {
+  TypeParam ilist;
+  EXPECT_TRUE(ilist.empty());
+  EXPECT_FALSE(ilist.front_val().has_value());
+  EXPECT_FALSE(ilist.back_val().has_value());
+
+  for (int i = 0; i < 50; ++i) {
+    ilist.push_back(i);
+    ilist.push_front(-i - 1);
+  }
+  EXPECT_EQ(ilist.size(), 100);
+  EXPECT_EQ(ilist.front_val(), -50);
+  EXPECT_EQ(ilist.back_val(), 49);
+
+  int val = 0;
+  EXPECT_TRUE(ilist.front(val));
+  EXPECT_EQ(val, -50);
+  EXPECT_TRUE(ilist.back(val));
+  EXPECT_EQ(val, 49);
+
+  for (int i = -50; i < 0; ++i) {
+    EXPECT_EQ(ilist.pop_front_value(), i);
+  }
+  for (int i = 49; i >= 0; --i) {
+    EXPECT_EQ(ilist.back_val(), i);
+    ilist.pop_back();
+  }
+  EXPECT_TRUE(ilist.empty());
+  ilist.pop_back();
+  ilist.pop_front();
+  EXPECT_EQ(ilist.size(), 0);
+}
+
+TYPED_TEST(UnrolledTest, SearchInsertRemove) {
+  TypeParam ilist;
+  for (int i = 0; i < 10; ++i) {
+    ilist.push_back(i % 5);
+  }
+  EXPECT_TRUE(ilist.insert_before(3, 30));
+  EXPECT_TRUE(ilist.insert_after(4, 40));
+  EXPECT_FALSE(ilist.insert_after(7, 70));
+  EXPECT_TRUE(ilist.remove_last(0));
+  EXPECT_TRUE(ilist.remove_first(1));
+  EXPECT_FALSE(ilist.remove_first(7));
+  ilist.insert_at(0, -1);
+  ilist.insert_at(4, 100);
+  ilist.insert_at(99, 99);
+  EXPECT_EQ(to_vector(ilist), (std::vector<int>{-1, 0, 2, 30, 100, 3, 4, 40, 1,
+                                                 2, 3, 4, 99}));
+
+  auto it = ilist.find(30);
+  ASSERT_NE(it, ilist.end());
+  *it = 31;
+  it  = ilist.erase(it);
+  EXPECT_EQ(*it, 100);
+  it = ilist.insert(it, 50);
+  EXPECT_EQ(*it, 50);
+  EXPECT_EQ(*ilist.rfind(4), 4);
+  ilist.erase(ilist.rfind(4));
+  EXPECT_EQ(ilist.find(42), ilist.end());
+  EXPECT_EQ(to_vector(ilist),
+            (std::vector<int>{-1, 0, 2, 50, 100, 3, 4, 40, 1, 2, 3, 99}));
+  EXPECT_EQ(ilist.count(2), 2);
+  EXPECT_EQ(ilist.count(99), 1);
+  EXPECT_EQ(ilist.count(42), 0);
+}
+
+// doubles are searched with vector compares, the chunks' windows don't
+// start on a vector boundary
+TEST(UnrolledYallTest, VectorSearch) {
+  yall::UnrolledYall<double, 37> dlist;
+  for (int i = 0; i < 500; ++i) {
+    dlist.push_back(i % 100);
+    dlist.push_front(-1 - i % 7);
+  }
+  EXPECT_EQ(dlist.count(42.0), 5);
+  EXPECT_EQ(dlist.count(-3.0), 72);
+  EXPECT_EQ(dlist.count(0.5), 0);
+  EXPECT_EQ(*std::next(dlist.find(99.0)), 0.0);
+  EXPECT_EQ(*std::prev(dlist.rfind(0.0)), 99.0);
+  EXPECT_TRUE(dlist.remove_last(99.0));
+  EXPECT_EQ(dlist.back_val(), 98.0);
+  EXPECT_TRUE(dlist.remove_first(-7.0));
+  EXPECT_EQ(dlist.count(-7.0), 70);
+  EXPECT_FALSE(dlist.remove_first(100.0));
+}
+
+// compare against std::list with random operations
+TYPED_TEST(UnrolledTest, Random) {
+  TypeParam ilist;
+  std::list<int> expected;
+  std::mt19937 gen(42);
+
+  for (int step = 0; step < 20000; ++step) {
+    const int val = static_cast<int>(gen() % 50);
+    switch (gen() % 9) {
+      case 0:
+        ilist.push_back(val);
+        expected.push_back(val);
+        break;
+      case 1:
+        ilist.push_front(val);
+        expected.push_front(val);
+        break;
+      case 2:
+        ilist.pop_front();
+        if (!expected.empty()) {
+          expected.pop_front();
+        }
+        break;
+      case 3:
+        ilist.pop_back();
+        if (!expected.empty()) {
+          expected.pop_back();
+        }
+        break;
+      case 4: {
+        const auto indx = expected.empty() ? 0 : gen() % (expected.size() + 1);
+        ilist.insert_at(indx, val);
+        auto pos = expected.begin();
+        std::advance(pos, indx);
+        expected.insert(pos, val);
+        break;
+      }
+      case 5: {
+        auto pos = std::find(expected.begin(), expected.end(), val);
+        EXPECT_EQ(ilist.remove_first(val), pos != expected.end());
+        if (pos != expected.end()) {
+          expected.erase(pos);
+        }
+        break;
+      }
+      case 6: {
+        auto pos = std::find(expected.rbegin(), expected.rend(), val);
+        EXPECT_EQ(ilist.remove_last(val), pos != expected.rend());
+        if (pos != expected.rend()) {
+          expected.erase(std::next(pos).base());
+        }
+        break;
+      }
+      case 7: {
+        auto pos = std::find(expected.begin(), expected.end(), val);
+        EXPECT_EQ(ilist.insert_after(val, -val), pos != expected.end());
+        if (pos != expected.end()) {
+          expected.insert(std::next(pos), -val);
+        }
+        break;
+      }
+      default: {
+        auto pos = std::find(expected.begin(), expected.end(), val);
+        EXPECT_EQ(ilist.insert_before(val, 100 + val), pos != expected.end());
+        if (pos != expected.end()) {
+          expected.insert(pos, 100 + val);
+        }
+        break;
+      }
+    }
+    ASSERT_EQ(ilist.size(), expected.size());
+    if (step % 500 == 0) {
+      ASSERT_EQ(to_vector(ilist),
+                std::vector<int>(expected.begin(), expected.end()));
+    }
+  }
+  ASSERT_EQ(to_vector(ilist), std::vector<int>(expected.begin(), expected.end()));
+}
+
+TEST(UnrolledYallTest, Strings) {
+  yall::UnrolledYall<std::string, 4> slist;
+  for (int i = 0; i < 20; ++i) {
+    slist.emplace_back(std::to_string(i));
+  }
+  slist.emplace_at(5, "five");
+  EXPECT_TRUE(slist.remove_first("7"));
+  EXPECT_EQ(*slist.find("five"), "five");
+  EXPECT_EQ(slist.size(), 20);
+
+  auto moved = std::move(slist);
+  EXPECT_TRUE(slist.empty());
+  EXPECT_EQ(moved.front_val(), "0");
+  EXPECT_EQ(moved.pop_back_value(), "19");
+
+  std::string joined;
+  for (const auto& s: moved) {
+    joined += s + ",";
+  }
+  EXPECT_EQ(joined, "0,1,2,3,4,five,5,6,8,9,10,11,12,13,14,15,16,17,18,");
+}